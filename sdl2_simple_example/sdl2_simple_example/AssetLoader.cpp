@@ -0,0 +1,407 @@
+#include "AssetLoader.h"
+#include "Logger.h"
+#include "AssetPath.h"
+#include <chrono>
+#include <algorithm>
+
+using hrclock = std::chrono::high_resolution_clock;
+
+AssetLoader::~AssetLoader() {
+    Stop();
+}
+
+void AssetLoader::Start(unsigned int workerCount) {
+    if (!workers.empty()) return;
+
+    if (workerCount == 0) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;  // Se deja un núcleo libre para el hilo principal
+    }
+
+    stopping = false;
+    for (unsigned int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&AssetLoader::WorkerLoop, this);
+    }
+}
+
+void AssetLoader::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (auto& job : jobs) {
+            job->cancelled = true;
+        }
+    }
+    wakeUp.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Los recursos a medio subir se destruyen aquí, mientras el contexto de OpenGL sigue vivo
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& job : jobs) {
+        job->textureStream.release();
+    }
+    queue.clear();
+    jobs.clear();
+}
+
+unsigned int AssetLoader::QueueModel(const std::string& path, ModelCallback onLoaded) {
+    auto job = std::make_shared<LoadJob>();
+    job->path = path;
+    job->key = MeshCache::GetKey(path);
+    job->onLoaded = std::move(onLoaded);
+    job->cached = MeshCache::GetInstance().Find(job->key);
+
+    bool needsWorker = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job->id = nextId++;
+        if (job->cached) {
+            job->state = LoadState::UPLOADING;  // Ya residente: Update lo termina en el próximo frame
+        }
+        else if (IsLoadingKey(job->key, nullptr)) {
+            job->waiting = true;                // Se reutilizará el resultado del trabajo que ya lo carga
+        }
+        else {
+            queue.push_back(job);
+            needsWorker = true;
+        }
+        jobs.push_back(job);
+    }
+    if (needsWorker) {
+        wakeUp.notify_one();
+    }
+
+    return job->id;
+}
+
+unsigned int AssetLoader::QueueTexture(std::shared_ptr<Texture> texture) {
+    auto job = std::make_shared<LoadJob>();
+    job->type = AssetType::TEXTURE;
+    job->path = texture->getPath();
+    job->key = GetAssetKey(job->path);
+    job->texture = std::move(texture);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job->id = nextId++;
+        queue.push_back(job);
+        jobs.push_back(job);
+    }
+    wakeUp.notify_one();
+
+    return job->id;
+}
+
+void AssetLoader::Cancel(unsigned int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& job : jobs) {
+        if (job->id != id) continue;
+
+        job->cancelled = true;
+        if (job->waiting) {
+            job->state = LoadState::CANCELLED;
+        }
+        // Si aún no lo ha cogido ningún hilo, se saca directamente de la cola
+        auto queued = std::find(queue.begin(), queue.end(), job);
+        if (queued != queue.end()) {
+            queue.erase(queued);
+            job->state = LoadState::CANCELLED;
+        }
+        break;
+    }
+}
+
+void AssetLoader::CancelAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& job : jobs) {
+        job->cancelled = true;
+        if (job->waiting) {
+            job->state = LoadState::CANCELLED;
+        }
+    }
+    for (auto& job : queue) {
+        job->state = LoadState::CANCELLED;
+    }
+    queue.clear();
+}
+
+void AssetLoader::WorkerLoop() {
+    while (true) {
+        std::shared_ptr<LoadJob> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = queue.front();
+            queue.pop_front();
+        }
+
+        if (job->cancelled) {
+            job->state = LoadState::CANCELLED;
+            continue;
+        }
+
+        // Lectura, importación y decodificación fuera del hilo principal (sin llamadas a OpenGL; el Logger sí se puede usar)
+        job->state = LoadState::READING;
+        ReadJob(*job);
+    }
+}
+
+// Lee el asset de un trabajo ya en READING y lo deja en UPLOADING, FAILED o CANCELLED
+void AssetLoader::ReadJob(LoadJob& job) {
+    bool loaded;
+    if (job.type == AssetType::TEXTURE) {
+        loaded = job.textureStream.read(job.path);
+    }
+    else {
+        loaded = ModelLoader::readMeshes(job.path, job.meshData, job.cookedFile);
+        job.totalMeshes = job.cookedFile ? job.cookedFile->getMeshCount() : job.meshData.size();
+    }
+
+    if (job.cancelled) {
+        job.state = LoadState::CANCELLED;
+    }
+    else if (!loaded) {
+        job.state = LoadState::FAILED;
+    }
+    else {
+        job.state = LoadState::UPLOADING;  // Publica los datos leídos al hilo principal
+    }
+}
+
+// Recurso a partir de lo que dejó el hilo de carga: el fichero cocinado mapeado o las mallas importadas
+std::shared_ptr<MeshResource> AssetLoader::CreateResource(LoadJob& job) {
+    if (job.cookedFile) {
+        return std::make_shared<MeshResource>(job.key, std::move(job.cookedFile));
+    }
+    return std::make_shared<MeshResource>(job.key, std::move(job.meshData));
+}
+
+std::shared_ptr<const MeshResource> AssetLoader::FinishModelNow(const std::string& key) {
+    while (true) {
+        std::shared_ptr<LoadJob> job;
+        bool claimed = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = FindLoadingJob(key, nullptr);
+            if (!job) return nullptr;
+
+            // Si ningún hilo lo ha cogido todavía, se lee aquí mismo en lugar de esperar turno en la cola
+            auto queued = std::find(queue.begin(), queue.end(), job);
+            if (queued != queue.end()) {
+                queue.erase(queued);
+                job->state = LoadState::READING;
+                claimed = true;
+            }
+        }
+        if (claimed) {
+            ReadJob(*job);
+        }
+
+        // Un hilo de carga ya lo sacó de la cola (aunque quizá aún no lo haya marcado como READING)
+        LoadState state = job->state;
+        if (state == LoadState::QUEUED || state == LoadState::READING) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        // Si falló o se canceló, se vuelve a mirar por si otro trabajo carga el mismo asset
+        if (state != LoadState::UPLOADING || job->cancelled) continue;
+
+        if (job->cached) return job->cached;
+
+        // Se sube todo lo que falte; Update lo verá terminado y avisará a quien lo encoló en el próximo frame
+        if (!job->resource) {
+            job->resource = CreateResource(*job);
+        }
+        job->resource->uploadAll();
+        return MeshCache::GetInstance().Add(job->key, job->resource);
+    }
+}
+
+void AssetLoader::Update(float budgetMs) {
+    const auto start = hrclock::now();
+    auto budgetExceeded = [&]() {
+        return std::chrono::duration<float, std::milli>(hrclock::now() - start).count() >= budgetMs;
+    };
+
+    std::vector<std::shared_ptr<LoadJob>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = jobs;
+    }
+
+    bool uploadedAny = false;
+    for (auto& job : snapshot) {
+        if (job->waiting) {
+            if (job->state == LoadState::CANCELLED) continue;
+
+            // Cuando el trabajo que carga el mismo asset termina, basta con compartir su recurso
+            if (std::shared_ptr<const MeshResource> resource = MeshCache::GetInstance().Find(job->key)) {
+                Finish(*job, resource);
+                continue;
+            }
+
+            // Si ese trabajo falló o se canceló, este pasa a cargarlo por su cuenta
+            bool requeued = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!IsLoadingKey(job->key, job.get())) {
+                    job->waiting = false;
+                    queue.push_back(job);
+                    requeued = true;
+                }
+            }
+            if (requeued) {
+                wakeUp.notify_one();
+            }
+            continue;
+        }
+
+        if (job->state != LoadState::UPLOADING) continue;
+
+        if (job->cancelled) {
+            job->resource.reset();
+            job->state = LoadState::CANCELLED;
+            continue;
+        }
+
+        if (job->type == AssetType::TEXTURE) {
+            // Un nivel cada vez, del mip más pequeño al más grande, con el mismo presupuesto que las mallas
+            bool remaining = !job->textureStream.isUploaded();
+            while (remaining && (!uploadedAny || !budgetExceeded())) {
+                remaining = job->textureStream.uploadNext(*job->texture);
+                uploadedAny = true;
+            }
+
+            if (remaining) break;
+
+            FinishTexture(*job);
+
+            if (budgetExceeded()) break;
+            continue;
+        }
+
+        if (job->cached) {
+            Finish(*job, job->cached);
+            continue;
+        }
+
+        if (!job->resource) {
+            job->resource = CreateResource(*job);
+        }
+
+        bool remaining = !job->resource->isUploaded();
+        while (remaining && (!uploadedAny || !budgetExceeded())) {
+            remaining = job->resource->uploadNext();
+            uploadedAny = true;
+        }
+
+        if (remaining) break;  // Presupuesto agotado; se sigue en el próximo frame
+
+        Finish(*job, MeshCache::GetInstance().Add(job->key, job->resource));
+
+        if (budgetExceeded()) break;
+    }
+
+    // Se retiran los trabajos terminados; los fallos se notifican después, ya sin el mutex
+    std::vector<AssetType> failed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [&failed](const std::shared_ptr<LoadJob>& job) {
+            LoadState state = job->state;
+            if (state != LoadState::DONE && state != LoadState::FAILED && state != LoadState::CANCELLED) {
+                return false;
+            }
+            if (state == LoadState::FAILED) {
+                failed.push_back(job->type);
+            }
+
+            // Una textura que no llegó se marca como fallida para que los materiales dejen de esperarla
+            if (job->texture && state != LoadState::DONE) {
+                job->texture->setFailed();
+                job->textureStream.release();
+            }
+            return true;
+        }), jobs.end());
+    }
+    for (AssetType type : failed) {
+        Logger::GetInstance().Log(type == AssetType::TEXTURE ? "TEXTURE INVALID TO ADD" : "OBJECT INVALID TO ADD", WARNING);
+    }
+}
+
+void AssetLoader::Finish(LoadJob& job, std::shared_ptr<const MeshResource> resource) {
+    auto gameObject = std::make_unique<GameObject>();
+    gameObject->setMesh(std::move(resource));
+
+    job.resource.reset();
+    job.cached.reset();
+    job.state = LoadState::DONE;
+
+    Logger::GetInstance().Log("OBJECT WAS SUCCESFULLY ADDED", INFO);
+    if (job.onLoaded) {
+        job.onLoaded(std::move(gameObject));
+    }
+}
+
+void AssetLoader::FinishTexture(LoadJob& job) {
+    job.texture.reset();
+    job.state = LoadState::DONE;
+    Logger::GetInstance().Log("TEXTURE WAS SUCCESSFULLY ADDED", INFO);
+}
+
+// Hay otro trabajo vivo leyendo o subiendo el mismo asset (se llama con el mutex tomado)
+bool AssetLoader::IsLoadingKey(const std::string& key, const LoadJob* except) const {
+    return FindLoadingJob(key, except) != nullptr;
+}
+
+std::shared_ptr<AssetLoader::LoadJob> AssetLoader::FindLoadingJob(const std::string& key, const LoadJob* except) const {
+    for (const auto& job : jobs) {
+        if (job.get() == except || job->waiting || job->cancelled || job->key != key) continue;
+
+        LoadState state = job->state;
+        if (state == LoadState::QUEUED || state == LoadState::READING || state == LoadState::UPLOADING) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+float AssetLoader::GetProgress(const LoadJob& job) {
+    switch (job.state.load()) {
+    case LoadState::READING:
+        return -1.0f;  // Assimp y la decodificación no informan de su avance
+    case LoadState::UPLOADING:
+        if (job.type == AssetType::TEXTURE && job.textureStream.getLevelCount() > 0) {
+            float uploaded = float(job.textureStream.getUploadedLevelCount());
+            return 0.5f + 0.5f * uploaded / float(job.textureStream.getLevelCount());
+        }
+        if (job.resource && job.totalMeshes > 0) {
+            float uploaded = float(job.resource->getUploadedMeshCount());
+            return 0.5f + 0.5f * uploaded / float(job.totalMeshes);
+        }
+        return 0.5f;
+    case LoadState::DONE:
+        return 1.0f;
+    default:
+        return 0.0f;
+    }
+}
+
+std::vector<LoadJobInfo> AssetLoader::GetJobs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<LoadJobInfo> infos;
+    infos.reserve(jobs.size());
+    for (const auto& job : jobs) {
+        infos.push_back({ job->id, job->path, job->state.load(), GetProgress(*job) });
+    }
+    return infos;
+}
+
+bool AssetLoader::HasPendingJobs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !jobs.empty();
+}
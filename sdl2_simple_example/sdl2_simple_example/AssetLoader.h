@@ -0,0 +1,115 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "GameObject.h"
+#include "MeshCache.h"
+#include "MeshCooker.h"
+#include "TextureManager.h"
+
+enum class LoadState {
+    QUEUED,     // Esperando a un hilo de carga
+    READING,    // Un hilo de carga está leyendo/importando el fichero
+    UPLOADING,  // Datos listos; el hilo principal los sube a la GPU por partes
+    DONE,
+    FAILED,
+    CANCELLED
+};
+
+enum class AssetType {
+    MODEL,
+    TEXTURE
+};
+
+// Resumen de un trabajo para mostrarlo en la interfaz
+struct LoadJobInfo {
+    unsigned int id;
+    std::string path;
+    LoadState state;
+    float progress;  // Negativo mientras no se conoce (lectura e importación en el hilo de carga)
+};
+
+// Servicio de carga en segundo plano: los hilos de trabajo leen e importan modelos y texturas y el hilo
+// principal solo hace la subida final a OpenGL, limitada por un presupuesto de tiempo por frame
+class AssetLoader {
+public:
+    using ModelCallback = std::function<void(std::unique_ptr<GameObject>)>;
+
+    static AssetLoader& GetInstance() {
+        static AssetLoader instance;
+        return instance;
+    }
+
+    void Start(unsigned int workerCount = 0);
+    void Stop();
+
+    // Encola un modelo; onLoaded se llama en el hilo principal con el GameObject ya listo para dibujar
+    unsigned int QueueModel(const std::string& path, ModelCallback onLoaded);
+
+    // Encola la lectura de una textura creada por TextureManager; sus mips se suben de menor a mayor
+    unsigned int QueueTexture(std::shared_ptr<Texture> texture);
+
+    // Hilo principal, para la carga síncrona: si un trabajo vivo ya carga este modelo, espera a su lectura, sube
+    // lo que falte y devuelve el recurso (ya en MeshCache). Devuelve nullptr si nadie lo está cargando.
+    std::shared_ptr<const MeshResource> FinishModelNow(const std::string& key);
+
+    void Cancel(unsigned int id);
+    void CancelAll();
+
+    // Hilo principal: sube mallas y niveles de textura pendientes hasta agotar el presupuesto (siempre al menos una)
+    void Update(float budgetMs);
+
+    std::vector<LoadJobInfo> GetJobs() const;
+    bool HasPendingJobs() const;
+
+private:
+    struct LoadJob {
+        unsigned int id = 0;
+        AssetType type = AssetType::MODEL;
+        std::string path;
+        std::string key;                         // Clave en MeshCache
+        ModelCallback onLoaded;
+        std::atomic<LoadState> state{ LoadState::QUEUED };
+        std::atomic<bool> cancelled{ false };
+
+        std::vector<MeshData> meshData;          // Escrito por el hilo de carga antes de pasar a UPLOADING
+        std::unique_ptr<CookedMeshFile> cookedFile;  // En su lugar, si el asset ya estaba cocinado
+        size_t totalMeshes = 0;
+
+        std::shared_ptr<Texture> texture;        // Solo en trabajos de textura
+        TextureStream textureStream;             // Leído por el hilo de carga, subido por el principal
+
+        // Solo se tocan desde el hilo principal
+        bool waiting = false;                            // Otro trabajo ya está cargando el mismo asset
+        std::shared_ptr<MeshResource> resource;          // Recurso en construcción mientras se sube
+        std::shared_ptr<const MeshResource> cached;      // Recurso ya residente, no hace falta leer nada
+    };
+
+    AssetLoader() = default;
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void WorkerLoop();
+    static void ReadJob(LoadJob& job);
+    static std::shared_ptr<MeshResource> CreateResource(LoadJob& job);
+    void Finish(LoadJob& job, std::shared_ptr<const MeshResource> resource);
+    void FinishTexture(LoadJob& job);
+    bool IsLoadingKey(const std::string& key, const LoadJob* except) const;
+    std::shared_ptr<LoadJob> FindLoadingJob(const std::string& key, const LoadJob* except) const;
+    static float GetProgress(const LoadJob& job);
+
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<LoadJob>> queue;  // Pendientes de leer
+    std::vector<std::shared_ptr<LoadJob>> jobs;  // Todos los trabajos vivos, en orden de llegada
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+    unsigned int nextId = 1;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <filesystem>
+#include <functional>
+#include <cstdio>
+
+// Clave normalizada de una ruta de asset, para que "Assets/x.fbx" y su ruta absoluta coincidan en las cachés
+inline std::string GetAssetKey(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    if (error) return path;
+    return absolute.lexically_normal().generic_string();
+}
+
+// Ruta del fichero cocinado de un asset: <directorio>/<nombre>_<hash><extensión>.
+// El hash de la ruta completa evita colisiones entre assets con el mismo nombre en carpetas distintas.
+inline std::string GetCookedAssetPath(const std::string& assetPath, const char* directory, const char* extension) {
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(std::hash<std::string>()(GetAssetKey(assetPath))));
+    std::string name = std::filesystem::path(assetPath).stem().string();
+    return std::string(directory) + "/" + name + "_" + hash + extension;
+}
+
+// El fichero cocinado existe y es más reciente que el asset original
+inline bool IsCookedAssetUpToDate(const std::string& assetPath, const std::string& cookedPath) {
+    std::error_code error;
+    std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedPath, error);
+    if (error) return false;
+    std::filesystem::file_time_type assetTime = std::filesystem::last_write_time(assetPath, error);
+    if (error) return false;
+    return cookedTime >= assetTime;
+}
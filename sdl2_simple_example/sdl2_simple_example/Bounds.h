@@ -0,0 +1,88 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+
+// Caja envolvente alineada con los ejes. Vacía (min > max) hasta que se le añade algo.
+struct AABB {
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+    glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+    glm::vec3 getSize() const { return isValid() ? max - min : glm::vec3(0.0f); }
+
+    void add(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void add(const AABB& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    // Caja que envuelve a esta tras aplicarle una transformación afín: se transforma el centro y
+    // la semidiagonal se proyecta con el valor absoluto de la parte lineal (sin recorrer las 8 esquinas)
+    AABB transformed(const glm::mat4& transform) const {
+        if (!isValid()) return *this;
+
+        glm::vec3 center = glm::vec3(transform * glm::vec4(getCenter(), 1.0f));
+        glm::vec3 extents = (max - min) * 0.5f;
+        glm::vec3 newExtents = glm::abs(glm::vec3(transform[0])) * extents.x
+                             + glm::abs(glm::vec3(transform[1])) * extents.y
+                             + glm::abs(glm::vec3(transform[2])) * extents.z;
+
+        AABB result;
+        result.min = center - newExtents;
+        result.max = center + newExtents;
+        return result;
+    }
+};
+
+struct BoundingSphere {
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+
+    // Esfera que envuelve a otra: se amplía lo justo para contenerla
+    void add(const BoundingSphere& other) {
+        radius = std::max(radius, glm::length(other.center - center) + other.radius);
+    }
+
+    // Con escala no uniforme el radio se multiplica por la escala mayor
+    BoundingSphere transformed(const glm::mat4& transform) const {
+        float scale = std::max({ glm::length(glm::vec3(transform[0])),
+                                 glm::length(glm::vec3(transform[1])),
+                                 glm::length(glm::vec3(transform[2])) });
+        BoundingSphere result;
+        result.center = glm::vec3(transform * glm::vec4(center, 1.0f));
+        result.radius = radius * scale;
+        return result;
+    }
+};
+
+// Prueba de las tres franjas: distancia a la que el rayo entra en la caja (0 si empieza dentro), o -1 si
+// no la toca antes de maxDistance. Con componentes de la dirección a cero la inversa es infinita y funciona igual.
+inline float RayBoxEnter(const AABB& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+    glm::vec3 t0 = (box.min - origin) * inverseDirection;
+    glm::vec3 t1 = (box.max - origin) * inverseDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    return enter <= exit ? enter : -1.0f;
+}
+
+// Rayo con dirección no necesariamente unitaria: las distancias se miden en múltiplos de direction, así que
+// un rayo llevado a espacio local con la inversa de la transformación conserva las mismas distancias
+struct Ray {
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    Ray transformed(const glm::mat4& transform) const {
+        Ray result;
+        result.origin = glm::vec3(transform * glm::vec4(origin, 1.0f));
+        result.direction = glm::vec3(transform * glm::vec4(direction, 0.0f));
+        return result;
+    }
+};
@@ -2,7 +2,7 @@
 #include <glm/gtc/matrix_transform.hpp> 
 
 glm::mat4 Camera::getProjectionMatrix(float aspectRatio) const {
-    return glm::perspective(glm::radians(zoom), aspectRatio, 0.1f, 100.0f);
+    return glm::perspective(glm::radians(zoom), aspectRatio, NEAR_PLANE, FAR_PLANE);
 }
 
 Camera::Camera()
@@ -12,6 +12,18 @@ Camera::Camera()
     updateCameraVectors();
 }
 
+Ray Camera::getPickRay(const glm::vec2& ndc, float aspectRatio) const {
+    // Se deshace proyeccin y vista para los puntos del plano cercano y del lejano bajo el cursor
+    glm::mat4 inverseViewProjection = glm::inverse(getProjectionMatrix(aspectRatio) * getViewMatrix());
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+    ray.direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - ray.origin);
+    return ray;
+}
+
 glm::mat4 Camera::getViewMatrix() const {
     return glm::lookAt(position, position + front, up);
 }
@@ -4,13 +4,20 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <SDL2/SDL_events.h>
+#include "Bounds.h"
 
 class Camera {
 public:
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f;
+
     Camera();
     glm::mat4 getViewMatrix() const;
     glm::mat4 getProjectionMatrix(float aspectRatio) const;
 
+    // Rayo de mundo que sale de la cámara por un punto de la pantalla en coordenadas normalizadas (-1..1)
+    Ray getPickRay(const glm::vec2& ndc, float aspectRatio) const;
+
     void processMouseMovement(float xoffset, float yoffset);
     void processMouseScroll(float yoffset);
     void processKeyboard(SDL_Keycode key, float deltaTime);
@@ -4,6 +4,12 @@
 #include <GL/glew.h>
 #include <GL/gl.h>
 #include <vector>
+#include <algorithm>
+#include <cstdio>
+#include "Renderer.h"
+#include "TransformSystem.h"
+#include "FramePacer.h"
+#include "Logger.h"
 
 // Asegrate de incluir el encabezado de Windows si ests usando funciones de memoria de Windows
 #ifdef _WIN32
@@ -13,28 +19,137 @@
 // Constructor de ConfigPanel
 ConfigPanel::ConfigPanel(MyWindow* window) : _window(window) {}
 ConfigPanel::~ConfigPanel() {}
-void ConfigPanel::UpdateFPS(float fps) {
-    frameCount++;
+static const char* FRAME_TIMES_CSV = "frame_times.csv";
+static const int HISTOGRAM_BINS = 40;
 
-    if (frameCount >= 10) {
-        frameCount = 0;
-        if (fpsHistory.size() >= maxSamples) {
-            fpsHistory.erase(fpsHistory.begin());
+void ConfigPanel::RecordFrameTime(float ms) {
+    frameTimes.Add(ms);
+}
+
+// Tiempos de frame sin promediar: grfica, percentiles, histograma y tirones respecto al presupuesto
+void ConfigPanel::RenderFrameTimes() {
+    if (frameTimes.GetCount() == 0) {
+        ImGui::Text("No frame time data yet.");
+        return;
+    }
+
+    FrameTimePercentiles percentiles = frameTimes.ComputePercentiles();
+    float budget = frameTimes.GetBudgetMs();
+    float latest = frameTimes.GetLatest();
+    ImGui::Text("Frame time: %.2f ms (%.0f FPS)", latest, latest > 0.0f ? 1000.0f / latest : 0.0f);
+
+    // La escala llega al doble del presupuesto para que los frames normales no queden aplastados por un pico
+    float plotMax = std::max(budget * 2.0f, percentiles.p99);
+    ImGui::PlotLines("##FrameTimes", frameTimes.GetData(), frameTimes.GetCount(), frameTimes.GetOffset(), nullptr,
+                     0.0f, plotMax, ImVec2(0, 80));
+    ImGui::Text("p50: %.2f  p95: %.2f  p99: %.2f  max: %.2f ms (%d frames)",
+                percentiles.p50, percentiles.p95, percentiles.p99, percentiles.maxMs, percentiles.samples);
+
+    float bins[HISTOGRAM_BINS];
+    frameTimes.BuildHistogram(bins, HISTOGRAM_BINS, plotMax);
+    char histogramLabel[48];
+    snprintf(histogramLabel, sizeof(histogramLabel), "0 - %.1f ms", plotMax);
+    ImGui::PlotHistogram("##FrameTimeHistogram", bins, HISTOGRAM_BINS, 0, histogramLabel, 0.0f, 3.4e38f, ImVec2(0, 60));
+
+    if (ImGui::SliderFloat("Frame Budget (ms)", &budget, 4.0f, 50.0f, "%.2f")) {
+        frameTimes.SetBudgetMs(budget);
+    }
+    ImGui::Text("Hitches: %d in window, %llu total", frameTimes.GetHitchCount(), (unsigned long long)frameTimes.GetTotalHitches());
+    std::vector<FrameHitch> hitches = frameTimes.GetRecentHitches();
+    if (!hitches.empty() && ImGui::TreeNode("Recent Hitches")) {
+        for (const FrameHitch& hitch : hitches) {
+            ImGui::BulletText("Frame %llu: %.2f ms", (unsigned long long)hitch.frame, hitch.ms);
         }
-        fpsHistory.push_back(fps);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::Button("Export CSV")) {
+        if (frameTimes.ExportCsv(FRAME_TIMES_CSV)) {
+            LOG_FORMAT(INFO, "Tiempos de frame guardados en %s", FRAME_TIMES_CSV);
+        }
+        else {
+            LOG_FORMAT(WARNING, "No se pudieron guardar los tiempos de frame en %s", FRAME_TIMES_CSV);
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        frameTimes.Clear();
     }
 }
 
 void ConfigPanel::Render() {
     ImGui::Begin("Configuration");
 
-    // Mostrar el historial de FPS
-    if (!fpsHistory.empty()) {
-        ImGui::Text("Frames per Second (FPS)");
-        ImGui::PlotLines("##FPS", fpsHistory.data(), fpsHistory.size(), 500, nullptr, 0.0f, 100.0f, ImVec2(200, 80));
+    RenderFrameTimes();
+
+    // Ritmo de frames: modo de sincronizacin y estabilidad de los tiempos recientes
+    ImGui::Separator();
+    FramePacer& framePacer = FramePacer::GetInstance();
+    PacingMode pacingMode = framePacer.GetMode();
+    if (ImGui::BeginCombo("Frame Pacing", FramePacer::GetModeName(pacingMode))) {
+        for (PacingMode mode : { PacingMode::VSYNC, PacingMode::ADAPTIVE_VSYNC, PacingMode::UNCAPPED, PacingMode::LOW_LATENCY }) {
+            if (ImGui::Selectable(FramePacer::GetModeName(mode), mode == pacingMode)) {
+                framePacer.SetMode(mode);
+            }
+        }
+        ImGui::EndCombo();
+    }
+    if (!framePacer.IsAdaptiveVsyncSupported()) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(no adaptive)");
+    }
+    if (pacingMode == PacingMode::LOW_LATENCY) {
+        int targetFps = framePacer.GetTargetFps();
+        if (ImGui::SliderInt("Target FPS", &targetFps, 30, 240)) {
+            framePacer.SetTargetFps(targetFps);
+        }
+    }
+    FrameTimingStats timing = framePacer.GetStats();
+    ImGui::Text("Frame time: %.2f ms  std dev: %.3f ms", timing.meanMs, timing.stdDevMs);
+    ImGui::Text("Min: %.2f ms  Max: %.2f ms (%d frames)", timing.minMs, timing.maxMs, timing.samples);
+
+    // Estadsticas de dibujado del ltimo frame
+    ImGui::Separator();
+    Renderer& renderer = Renderer::GetInstance();
+    const RenderStats& stats = renderer.GetStats();
+    bool culling = renderer.IsCullingEnabled();
+    if (ImGui::Checkbox("Frustum Culling", &culling)) {
+        renderer.SetCullingEnabled(culling);
+    }
+    bool instancing = renderer.IsInstancingEnabled();
+    if (ImGui::Checkbox("GPU Instancing", &instancing)) {
+        renderer.SetInstancingEnabled(instancing);
+    }
+    if (!renderer.IsInstancingSupported()) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(not supported)");
+    }
+    bool corePath = renderer.IsCorePathEnabled();
+    if (ImGui::Checkbox("Core Profile Shaders (GL 3.3)", &corePath)) {
+        renderer.SetCorePathEnabled(corePath);
+    }
+    if (!renderer.IsCorePathSupported()) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(not supported)");
+    }
+    ImGui::Text("Render path: %s", renderer.IsUsingCorePath() ? "GLSL 330 + uniform buffers" : "Fixed function");
+    ImGui::Text("Objects: %d  Drawn: %d  Culled: %d", stats.objectCount, stats.drawnCount, stats.culledCount);
+    ImGui::Text("Draw calls: %d  Instanced: %d objects in %d batches", stats.drawCalls, stats.instancedObjects, stats.instancedBatches);
+    ImGui::Text("State binds: %d issued, %d saved", stats.bindsIssued, stats.bindsSaved);
+    if (uiFrame) {
+        // Tiempos del frame de interfaz anterior (el actual se est construyendo)
+        const UITimings& ui = uiFrame->GetTimings();
+        ImGui::Text("UI: build %.3f ms  draw %.3f ms (CPU)", ui.buildMs, ui.drawMs);
+    }
+
+    // Actualizacin de 100k transformaciones por frame: lote SSE del TransformSystem frente a glm objeto a objeto
+    static TransformSystem::BenchmarkResult benchmark;
+    if (ImGui::Button("Benchmark 100k Transforms")) {
+        benchmark = TransformSystem::RunBenchmark(100000, 20);
     }
-    else {
-        ImGui::Text("No FPS data yet.");
+    if (benchmark.count > 0) {
+        ImGui::Text("TransformSystem: %.3f ms/frame  Old GameObject layout: %.3f ms/frame (%.1fx)", benchmark.systemMs, benchmark.legacyMs,
+                    benchmark.systemMs > 0.0f ? benchmark.legacyMs / benchmark.systemMs : 0.0f);
     }
 
     // Informacin de versiones de software
@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include "FrameTimeHistory.h"
+#include "UIFrame.h"
 #include "MyWindow.h"  // Incluimos el header de MyWindow
 
 class ConfigPanel {
@@ -8,14 +10,18 @@ public:
     ConfigPanel(MyWindow* window);  // Constructor que recibe el puntero a MyWindow
     ~ConfigPanel();
 
-    void UpdateFPS(float fps);
+    // Tiempo del último frame, en milisegundos
+    void RecordFrameTime(float ms);
+    // Frame de interfaz cuyo coste se muestra junto a las estadísticas de dibujado
+    void SetUIFrame(const UIFrame* frame) { uiFrame = frame; }
     void Render();
     void Log(const char* message);
 
 private:
     MyWindow* _window;  // Puntero a la ventana MyWindow
 
-    std::vector<float> fpsHistory;
-    int frameCount = 0;
-    static const int maxSamples = 100;
+    void RenderFrameTimes();
+
+    FrameTimeHistory frameTimes;
+    const UIFrame* uiFrame = nullptr;
 };
@@ -1,56 +1,139 @@
 // ConsolePanel.cpp
 #include "ConsolePanel.h"
-#include <iostream>
+#include <cstdio>
 
-ConsolePanel::ConsolePanel() {
-    // Reserva de espacio en el vector para 1000 mensajes
-    messages.reserve(1000);
+static const char* TYPE_NAMES[LOG_TYPE_COUNT] = { "INFO", "WARNING", "INTRO" };
+static const ImVec4 TYPE_COLORS[LOG_TYPE_COUNT] = {
+    ImVec4(0.5f, 0.8f, 1.0f, 1.0f),  // Azul para INFO
+    ImVec4(1.0f, 0.8f, 0.0f, 1.0f),  // Amarillo para WARNING
+    ImVec4(1.0f, 0.2f, 0.2f, 1.0f)   // Rojo para ERROR
+};
+
+ConsolePanel::ConsolePanel() : startTime(std::chrono::system_clock::now()) {
+    // El anillo se crea entero al principio: registrar un mensaje nunca mueve los dems
+    entries.resize(CAPACITY);
+    filtered.reserve(1024);
 }
 
 ConsolePanel::~ConsolePanel() {}
 
+bool ConsolePanel::PassesFilter(const LogRecord& entry) const {
+    if (!showType[entry.type]) return false;
+    if (!textFilter.IsActive()) return true;
+
+    size_t length = entry.Format(formatBuffer, sizeof(formatBuffer));
+    return textFilter.PassFilter(formatBuffer, formatBuffer + length);
+}
+
+void ConsolePanel::RebuildFilterIndex() {
+    filtered.clear();
+    filteredStart = 0;
+    for (uint64_t sequence = firstSequence; sequence < nextSequence; sequence++) {
+        if (PassesFilter(GetEntry(sequence))) {
+            filtered.push_back(sequence);
+        }
+    }
+}
+
+void ConsolePanel::Clear() {
+    firstSequence = nextSequence;
+    filtered.clear();
+    filteredStart = 0;
+    for (int& count : typeCounts) count = 0;
+}
+
 void ConsolePanel::Render() {
     ImGui::Begin("Console");
 
-    // Mostrar los mensajes en la consola con colores segn el tipo de mensaje
-    for (const auto& message : messages) {
-        if (message.find("[INFO]") != std::string::npos) {
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.8f, 1.0f, 1.0f));  // Azul para INFO
-        }
-        else if (message.find("[WARNING]") != std::string::npos) {
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.0f, 1.0f));  // Amarillo para WARNING
-        }
-        else if (message.find("[INTRO]") != std::string::npos) {
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.2f, 0.2f, 1.0f));  // Rojo para ERROR
+    // Filtros por tipo (con el nmero de mensajes de cada uno) y por texto
+    bool filterChanged = false;
+    for (int type = 0; type < LOG_TYPE_COUNT; type++) {
+        char label[32];
+        snprintf(label, sizeof(label), "%s (%d)", TYPE_NAMES[type], typeCounts[type]);
+        ImGui::PushID(type);
+        filterChanged |= ImGui::Checkbox(label, &showType[type]);
+        ImGui::PopID();
+        ImGui::SameLine();
+    }
+    if (ImGui::SmallButton("Clear")) {
+        Clear();
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto-scroll", &autoScroll);
+    filterChanged |= textFilter.Draw("Filter", 200.0f);
+    if (filterChanged) {
+        RebuildFilterIndex();
+    }
+    ImGui::Separator();
+
+    // Solo se dibujan las filas visibles: el coste por frame no depende de cuntos mensajes haya
+    ImGui::BeginChild("ConsoleScroll", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+    int rowCount = int(filtered.size() - filteredStart);
+    ImGuiListClipper clipper;
+    clipper.Begin(rowCount);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const LogRecord& entry = GetEntry(filtered[filteredStart + row]);
+            float time = std::chrono::duration<float>(entry.time - startTime).count();
+            entry.Format(formatBuffer, sizeof(formatBuffer));
+            ImGui::PushStyleColor(ImGuiCol_Text, TYPE_COLORS[entry.type]);
+            if (entry.repeat > 1) {
+                ImGui::Text("%9.3f [%s] %s (x%u)", time, TYPE_NAMES[entry.type], formatBuffer, entry.repeat);
+            }
+            else {
+                ImGui::Text("%9.3f [%s] %s", time, TYPE_NAMES[entry.type], formatBuffer);
+            }
+            ImGui::PopStyleColor();  // Restaurar el color
         }
+    }
+    clipper.End();
 
-        ImGui::TextUnformatted(message.c_str());
-        ImGui::PopStyleColor();  // Restaurar el color
+    if (autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
+        ImGui::SetScrollHereY(1.0f);
     }
+    ImGui::EndChild();
 
     ImGui::End();
 }
 
 
 void ConsolePanel::Log(const char* message, LogType type) {
-    std::cout << "ConsolePanel: Agregando mensaje: " << message << std::endl;  // Debug
-    std::string formattedMessage;
-    switch (type) {
-        case INFO:
-            formattedMessage = "[INFO] " + std::string(message);
-            break;
-        case WARNING:
-            formattedMessage = "[WARNING] " + std::string(message);
-            break;
-        case INTRO:
-            formattedMessage = "[INTRO] " + std::string(message);
-            break;
-    }
-
-    messages.push_back(formattedMessage);  // Agregar al vector
-
-    // Limitar el nmero de mensajes a 1000
-    if (messages.size() > 1000) {
-        messages.erase(messages.begin());
+    LogRecord record;
+    record.Capture(type, LogFormats::TEXT, message);
+    Add(record);
+}
+
+void ConsolePanel::Add(const LogRecord& record) {
+    // Un mensaje idntico al anterior no ocupa otra fila
+    if (nextSequence > firstSequence) {
+        LogRecord& last = entries[(nextSequence - 1) % CAPACITY];
+        if (last.SameMessage(record)) {
+            last.repeat += record.repeat;
+            last.time = record.time;
+            return;
+        }
+    }
+
+    // Al llenarse el anillo, el mensaje nuevo ocupa el sitio del ms antiguo
+    if (nextSequence - firstSequence == CAPACITY) {
+        typeCounts[GetEntry(firstSequence).type]--;
+        firstSequence++;
+        if (filteredStart < filtered.size() && filtered[filteredStart] < firstSequence) {
+            filteredStart++;
+        }
+    }
+
+    LogRecord& entry = entries[nextSequence % CAPACITY];
+    entry = record;
+    typeCounts[record.type]++;
+
+    if (PassesFilter(entry)) {
+        // Lo descartado del principio del ndice se compacta de golpe cuando ya es la mitad
+        if (filteredStart > 0 && filteredStart * 2 >= filtered.size()) {
+            filtered.erase(filtered.begin(), filtered.begin() + filteredStart);
+            filteredStart = 0;
+        }
+        filtered.push_back(nextSequence);
     }
+    nextSequence++;
 }
@@ -3,17 +3,16 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <chrono>
 #include "imgui.h"
-
-enum LogType {
-    INFO,
-    WARNING,
-    INTRO
-
-};
+#include "LogRecord.h"
 
 class ConsolePanel {
 public:
+    // Mensajes que se conservan; al llenarse se sobrescriben los ms antiguos
+    static constexpr size_t CAPACITY = 131072;
+
     ConsolePanel();
     ~ConsolePanel();
 
@@ -21,9 +20,35 @@ public:
 
 
     void Log(const char* message, LogType type = INFO);
+    // Mensaje sin formatear del Logger; si repite el ltimo solo aumenta su contador
+    void Add(const LogRecord& record);
+    void Clear();
+
+    size_t GetMessageCount() const { return size_t(nextSequence - firstSequence); }
 
 private:
-    std::vector<std::string> messages;
+    const LogRecord& GetEntry(uint64_t sequence) const { return entries[sequence % CAPACITY]; }
+    bool PassesFilter(const LogRecord& entry) const;
+    void RebuildFilterIndex();
+
+    // Anillo de mensajes: cada uno tiene un nmero de secuencia y vive en entries[secuencia % CAPACITY].
+    // Se guardan sin formatear; el texto solo se compone para las filas visibles (y para el filtro de texto).
+    std::vector<LogRecord> entries;
+    uint64_t firstSequence = 0;  // Mensaje ms antiguo que sigue en el anillo
+    uint64_t nextSequence = 0;
+    int typeCounts[LOG_TYPE_COUNT] = {};
+
+    // ndice de los mensajes que pasan el filtro, en orden. Se aade al registrar y solo se reconstruye
+    // entero cuando cambia el filtro; los que salen del anillo se descartan por delante.
+    std::vector<uint64_t> filtered;
+    size_t filteredStart = 0;
+
+    ImGuiTextFilter textFilter;
+    bool showType[LOG_TYPE_COUNT] = { true, true, true };
+    bool autoScroll = true;
+
+    std::chrono::system_clock::time_point startTime;
+    mutable char formatBuffer[1024];
 };
 
 #endif
\ No newline at end of file
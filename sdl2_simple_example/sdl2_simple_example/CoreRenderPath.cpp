@@ -0,0 +1,204 @@
+#include <GL/glew.h>
+#include "CoreRenderPath.h"
+#include "GameObject.h"
+#include "MeshCache.h"
+#include "RenderQueue.h"
+#include "Logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstring>
+
+// Puntos de enlace de los uniform buffers, compartidos por los dos programas
+static const unsigned int CAMERA_BINDING = 0;
+static const unsigned int OBJECT_BINDING = 1;
+
+static const char* MESH_VERTEX_SHADER = R"(
+#version 330 core
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+};
+layout(std140) uniform Object {
+    mat4 model;
+    vec4 color;
+    int useTexture;
+};
+in vec3 position;
+in vec2 texCoord;
+out vec2 uv;
+void main() {
+    uv = texCoord;
+    gl_Position = viewProjection * (model * vec4(position, 1.0));
+}
+)";
+
+static const char* MESH_FRAGMENT_SHADER = R"(
+#version 330 core
+layout(std140) uniform Object {
+    mat4 model;
+    vec4 color;
+    int useTexture;
+};
+uniform sampler2D diffuseTexture;
+in vec2 uv;
+out vec4 fragColor;
+void main() {
+    fragColor = useTexture != 0 ? texture(diffuseTexture, uv) : color;
+}
+)";
+
+static const char* INSTANCED_VERTEX_SHADER = R"(
+#version 330 core
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+};
+in vec3 position;
+in vec2 texCoord;
+in mat4 instanceModel;
+out vec2 uv;
+void main() {
+    uv = texCoord;
+    gl_Position = viewProjection * (instanceModel * vec4(position, 1.0));
+}
+)";
+
+static const char* INSTANCED_FRAGMENT_SHADER = R"(
+#version 330 core
+uniform sampler2D diffuseTexture;
+uniform bool useTexture;
+uniform vec3 color;
+in vec2 uv;
+out vec4 fragColor;
+void main() {
+    fragColor = useTexture ? texture(diffuseTexture, uv) : vec4(color, 1.0);
+}
+)";
+
+bool CoreRenderPath::Init(unsigned int instanceMatrixLocation) {
+    if (state != State::UNINITIALIZED) return state == State::READY;
+
+    state = State::UNSUPPORTED;
+    if (!GLEW_VERSION_3_3) {
+        Logger::GetInstance().Log("OpenGL 3.3 no disponible: se dibuja con el pipeline fijo", WARNING);
+        return false;
+    }
+
+    const std::vector<std::pair<const char*, unsigned int>> meshAttributes = {
+        { "position", Mesh::POSITION_LOCATION }, { "texCoord", Mesh::TEXCOORD_LOCATION } };
+    std::vector<std::pair<const char*, unsigned int>> instancedAttributes = meshAttributes;
+    instancedAttributes.push_back({ "instanceModel", instanceMatrixLocation });
+
+    if (!meshShader.compile(MESH_VERTEX_SHADER, MESH_FRAGMENT_SHADER, meshAttributes) ||
+        !instancedShader.compile(INSTANCED_VERTEX_SHADER, INSTANCED_FRAGMENT_SHADER, instancedAttributes)) {
+        meshShader.release();
+        instancedShader.release();
+        return false;
+    }
+
+    meshShader.bindUniformBlock("Camera", CAMERA_BINDING);
+    meshShader.bindUniformBlock("Object", OBJECT_BINDING);
+    instancedShader.bindUniformBlock("Camera", CAMERA_BINDING);
+
+    meshShader.use();
+    glUniform1i(meshShader.getUniformLocation("diffuseTexture"), 0);
+    instancedShader.use();
+    glUniform1i(instancedShader.getUniformLocation("diffuseTexture"), 0);
+    useTextureLocation = instancedShader.getUniformLocation("useTexture");
+    colorLocation = instancedShader.getUniformLocation("color");
+    Shader::unbind();
+
+    // Cada tramo del buffer de objetos tiene que empezar en un múltiplo de la alineación que pide el driver
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    size_t align = size_t(std::max(alignment, 1));
+    objectStride = (sizeof(ObjectUniforms) + align - 1) / align * align;
+
+    glGenBuffers(1, &cameraBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glGenBuffers(1, &objectBuffer);
+
+    state = State::READY;
+    return true;
+}
+
+void CoreRenderPath::Release() {
+    meshShader.release();
+    instancedShader.release();
+    if (cameraBuffer) {
+        glDeleteBuffers(1, &cameraBuffer);
+        cameraBuffer = 0;
+    }
+    if (objectBuffer) {
+        glDeleteBuffers(1, &objectBuffer);
+        objectBuffer = 0;
+    }
+    objectBufferCapacity = 0;
+    state = State::UNINITIALIZED;
+}
+
+void CoreRenderPath::BeginFrame(const glm::mat4& view, const glm::mat4& projection) {
+    CameraUniforms camera;
+    camera.view = view;
+    camera.projection = projection;
+    camera.viewProjection = projection * view;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraUniforms), &camera);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, cameraBuffer);
+}
+
+void CoreRenderPath::UploadObjects(const std::vector<GameObject*>& objects) {
+    if (objects.empty()) return;
+
+    // Con la misma escala y el mismo color que el pipeline fijo: la textura modulada por blanco o el color por defecto
+    const glm::vec3 modelScale(ModelLoader::MODEL_SCALE);
+    objectData.resize(objects.size() * objectStride);
+    for (size_t i = 0; i < objects.size(); i++) {
+        GameObject& gameObject = *objects[i];
+        const Material& material = gameObject.getMaterial();
+        unsigned int textureID = material.getTextureID();
+
+        ObjectUniforms uniforms = {};
+        uniforms.model = glm::scale(gameObject.getTransform(), modelScale);
+        uniforms.color = glm::vec4(textureID ? glm::vec3(1.0f) : material.getDefaultColor(), 1.0f);
+        uniforms.useTexture = textureID ? 1 : 0;
+        std::memcpy(&objectData[i * objectStride], &uniforms, sizeof(ObjectUniforms));
+    }
+
+    // Una sola subida por frame, con el buffer huérfano como el de instancias
+    glBindBuffer(GL_UNIFORM_BUFFER, objectBuffer);
+    objectBufferCapacity = std::max(objectBufferCapacity, objectData.size());
+    glBufferData(GL_UNIFORM_BUFFER, GLsizeiptr(objectBufferCapacity), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, GLsizeiptr(objectData.size()), objectData.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+int CoreRenderPath::DrawObject(size_t slot, GameObject& gameObject, RenderStateCache& stateCache) {
+    const std::shared_ptr<const MeshResource>& mesh = gameObject.getModelLoader().getMesh();
+    if (!mesh) return 0;
+
+    stateCache.useProgram(meshShader.getProgram());
+    unsigned int textureID = gameObject.getMaterial().getTextureID();
+    if (textureID) stateCache.bindTexture(textureID);
+    glBindBufferRange(GL_UNIFORM_BUFFER, OBJECT_BINDING, objectBuffer, GLintptr(slot * objectStride), sizeof(ObjectUniforms));
+
+    for (const Mesh& part : mesh->getMeshes()) {
+        part.draw();
+    }
+    return int(mesh->getMeshCount());
+}
+
+void CoreRenderPath::UseInstancedProgram(RenderStateCache& stateCache, unsigned int textureID, const glm::vec3& color) {
+    stateCache.useProgram(instancedShader.getProgram());
+    if (textureID) stateCache.bindTexture(textureID);
+    glUniform1i(useTextureLocation, textureID ? GL_TRUE : GL_FALSE);
+    if (!textureID) {
+        glUniform3f(colorLocation, color.r, color.g, color.b);
+    }
+}
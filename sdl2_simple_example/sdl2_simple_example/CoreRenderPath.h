@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "Shader.h"
+
+class GameObject;
+class RenderStateCache;
+
+// Camino de dibujo del perfil core de OpenGL 3.3: programas GLSL 330, la cámara en un uniform buffer que se sube
+// una vez por frame y los datos de cada objeto (modelo, color, textura) en otro uniform buffer con un tramo por
+// objeto, que se elige en cada llamada con glBindBufferRange. No usa matrices de OpenGL ni modo inmediato.
+// Si la GPU no llega a 3.3 o los shaders no compilan, el Renderer sigue con el pipeline fijo.
+class CoreRenderPath {
+public:
+    // Compila los programas y crea los buffers la primera vez; false si el camino no está disponible.
+    // Las matrices de instancia se leen de los atributos instanceMatrixLocation..+3.
+    bool Init(unsigned int instanceMatrixLocation);
+    bool IsSupported() const { return state != State::UNSUPPORTED; }
+
+    // Borra los programas y los uniform buffers; con el contexto aún activo (lo llama Renderer::Shutdown)
+    void Release();
+
+    // Sube la vista y la proyección del frame
+    void BeginFrame(const glm::mat4& view, const glm::mat4& projection);
+
+    // Sube de una vez los datos de los objetos que se dibujan sueltos; DrawObject recibe su posición en la lista
+    void UploadObjects(const std::vector<GameObject*>& objects);
+    // Devuelve las llamadas de dibujo emitidas
+    int DrawObject(size_t slot, GameObject& gameObject, RenderStateCache& stateCache);
+
+    // Deja activo el programa de instancias con el material del lote
+    void UseInstancedProgram(RenderStateCache& stateCache, unsigned int textureID, const glm::vec3& color);
+
+private:
+    enum class State { UNINITIALIZED, READY, UNSUPPORTED };
+
+    // Misma disposición que los bloques std140 de los shaders
+    struct CameraUniforms {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProjection;
+    };
+
+    struct ObjectUniforms {
+        glm::mat4 model;
+        glm::vec4 color;
+        int useTexture;
+        int padding[3];
+    };
+
+    State state = State::UNINITIALIZED;
+    Shader meshShader;
+    Shader instancedShader;
+    int useTextureLocation = -1;
+    int colorLocation = -1;
+
+    unsigned int cameraBuffer = 0;
+    unsigned int objectBuffer = 0;
+    size_t objectStride = 0;          // sizeof(ObjectUniforms) redondeado a la alineación de glBindBufferRange
+    size_t objectBufferCapacity = 0;
+    std::vector<unsigned char> objectData;  // Se reutiliza entre frames
+};
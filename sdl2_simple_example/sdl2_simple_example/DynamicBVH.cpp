@@ -0,0 +1,383 @@
+#include "DynamicBVH.h"
+#include <algorithm>
+#include <queue>
+#include <cfloat>
+
+// Margen de las cajas gordas: una fracción del tamaño del objeto más un mínimo absoluto
+static const float FAT_MARGIN_RATIO = 0.1f;
+static const float FAT_MARGIN_MIN = 0.05f;
+
+static float SurfaceArea(const AABB& box) {
+    glm::vec3 size = box.max - box.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+static AABB Union(const AABB& a, const AABB& b) {
+    AABB result = a;
+    result.add(b);
+    return result;
+}
+
+static bool Contains(const AABB& outer, const AABB& inner) {
+    return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+static bool Overlaps(const AABB& a, const AABB& b) {
+    return glm::all(glm::lessThanEqual(a.min, b.max)) && glm::all(glm::greaterThanEqual(a.max, b.min));
+}
+
+static AABB Fatten(const AABB& box) {
+    glm::vec3 margin = (box.max - box.min) * FAT_MARGIN_RATIO + glm::vec3(FAT_MARGIN_MIN);
+    AABB fat;
+    fat.min = box.min - margin;
+    fat.max = box.max + margin;
+    return fat;
+}
+
+static float DistanceSquared(const AABB& box, const glm::vec3& point) {
+    glm::vec3 closest = glm::clamp(point, box.min, box.max);
+    glm::vec3 offset = point - closest;
+    return glm::dot(offset, offset);
+}
+
+DynamicBVH::DynamicBVH() : root(NULL_NODE), freeList(NULL_NODE), proxyCount(0) {}
+
+int DynamicBVH::AllocateNode() {
+    if (freeList == NULL_NODE) {
+        nodes.emplace_back();
+        nodes.back().height = 0;
+        return int(nodes.size()) - 1;
+    }
+
+    int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node();
+    nodes[node].height = 0;
+    return node;
+}
+
+void DynamicBVH::FreeNode(int node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    nodes[node].userData = nullptr;
+    freeList = node;
+}
+
+int DynamicBVH::CreateProxy(const AABB& box, void* userData) {
+    int proxy = AllocateNode();
+    nodes[proxy].box = Fatten(box);
+    nodes[proxy].userData = userData;
+    InsertLeaf(proxy);
+    proxyCount++;
+    return proxy;
+}
+
+void DynamicBVH::DestroyProxy(int proxy) {
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    proxyCount--;
+}
+
+bool DynamicBVH::MoveProxy(int proxy, const AABB& box) {
+    if (Contains(nodes[proxy].box, box)) return false;
+
+    RemoveLeaf(proxy);
+    nodes[proxy].box = Fatten(box);
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicBVH::ReplaceChild(int parent, int oldChild, int newChild) {
+    if (parent == NULL_NODE) {
+        root = newChild;
+    }
+    else if (nodes[parent].child1 == oldChild) {
+        nodes[parent].child1 = newChild;
+    }
+    else {
+        nodes[parent].child2 = newChild;
+    }
+}
+
+void DynamicBVH::InsertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Se baja por el árbol eligiendo en cada nivel lo que menos superficie añade: crear el nuevo
+    // nodo aquí o seguir por uno de los hijos (pagando lo que crecen los ancestros)
+    const AABB leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        float area = SurfaceArea(node.box);
+        float combinedArea = SurfaceArea(Union(node.box, leafBox));
+
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](int child) {
+            const Node& childNode = nodes[child];
+            float enlarged = SurfaceArea(Union(childNode.box, leafBox));
+            if (childNode.isLeaf()) return enlarged + inheritanceCost;
+            return enlarged - SurfaceArea(childNode.box) + inheritanceCost;
+        };
+        float cost1 = childCost(node.child1);
+        float cost2 = childCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = AllocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = Union(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+    ReplaceChild(oldParent, sibling, newParent);
+
+    // Se suben las cajas y alturas hasta la raíz, reequilibrando por el camino
+    index = nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = Balance(index);
+        Node& node = nodes[index];
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+        node.box = Union(nodes[node.child1].box, nodes[node.child2].box);
+        index = node.parent;
+    }
+}
+
+void DynamicBVH::RemoveLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    // El hermano ocupa el sitio del padre, que desaparece
+    ReplaceChild(grandParent, parent, sibling);
+    nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int index = grandParent;
+    while (index != NULL_NODE) {
+        index = Balance(index);
+        Node& node = nodes[index];
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+        node.box = Union(nodes[node.child1].box, nodes[node.child2].box);
+        index = node.parent;
+    }
+}
+
+// Si un hijo es más de un nivel más alto que el otro, se sube un nivel con una rotación y el
+// nieto más bajo pasa al nodo que baja. Devuelve el nodo que queda en la posición de iA.
+int DynamicBVH::Balance(int iA) {
+    Node& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2) return iA;
+
+    int iB = A.child1;
+    int iC = A.child2;
+    Node& B = nodes[iB];
+    Node& C = nodes[iC];
+    int balance = C.height - B.height;
+
+    if (balance > 1) {
+        // C sube
+        int iF = C.child1;
+        int iG = C.child2;
+        Node& F = nodes[iF];
+        Node& G = nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+        ReplaceChild(C.parent, iA, iC);
+
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = Union(B.box, G.box);
+            C.box = Union(A.box, F.box);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = Union(B.box, F.box);
+            C.box = Union(A.box, G.box);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    if (balance < -1) {
+        // B sube
+        int iD = B.child1;
+        int iE = B.child2;
+        Node& D = nodes[iD];
+        Node& E = nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+        ReplaceChild(B.parent, iA, iB);
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = Union(C.box, E.box);
+            B.box = Union(A.box, D.box);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = Union(C.box, D.box);
+            B.box = Union(A.box, E.box);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+// Recorrido de nodos (en la pila, el segundo valor indica que el subárbol ya está entero dentro del frustum)
+void DynamicBVH::QueryFrustum(const Frustum& frustum, const std::function<void(int proxy)>& callback) const {
+    if (root == NULL_NODE) return;
+
+    std::vector<std::pair<int, bool>> stack;
+    stack.reserve(64);
+    stack.push_back({ root, false });
+    while (!stack.empty()) {
+        auto [index, inside] = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+
+        if (!inside) {
+            Frustum::Result result = frustum.classify(node.box);
+            if (result == Frustum::OUTSIDE) continue;
+            inside = result == Frustum::INSIDE;
+        }
+
+        if (node.isLeaf()) {
+            callback(index);
+        }
+        else {
+            stack.push_back({ node.child1, inside });
+            stack.push_back({ node.child2, inside });
+        }
+    }
+}
+
+void DynamicBVH::QueryAABB(const AABB& box, const std::function<void(int proxy)>& callback) const {
+    if (root == NULL_NODE) return;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+        if (!Overlaps(node.box, box)) continue;
+
+        if (node.isLeaf()) {
+            callback(index);
+        }
+        else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicBVH::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                          const std::function<float(int proxy, float maxDistance)>& callback) const {
+    if (root == NULL_NODE) return;
+
+    glm::vec3 inverseDirection = 1.0f / direction;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+        if (RayBoxEnter(node.box, origin, inverseDirection, maxDistance) < 0.0f) continue;
+
+        if (node.isLeaf()) {
+            maxDistance = callback(index, maxDistance);
+            if (maxDistance <= 0.0f) return;
+            continue;
+        }
+
+        // Se apila primero el hijo más lejano para visitar antes el cercano y podar más con su impacto
+        int child1 = node.child1;
+        int child2 = node.child2;
+        float enter1 = RayBoxEnter(nodes[child1].box, origin, inverseDirection, maxDistance);
+        float enter2 = RayBoxEnter(nodes[child2].box, origin, inverseDirection, maxDistance);
+        if (enter1 >= 0.0f && enter2 >= 0.0f) {
+            if (enter1 < enter2) std::swap(child1, child2);
+            stack.push_back(child1);
+            stack.push_back(child2);
+        }
+        else if (enter1 >= 0.0f) {
+            stack.push_back(child1);
+        }
+        else if (enter2 >= 0.0f) {
+            stack.push_back(child2);
+        }
+    }
+}
+
+// Búsqueda de mejor primero: se expande siempre el nodo cuya caja está más cerca del punto y se para
+// cuando la caja más cercana pendiente ya está más lejos que el mejor resultado
+int DynamicBVH::QueryNearest(const glm::vec3& point, float maxDistance, const std::function<float(int proxy)>& distance) const {
+    if (root == NULL_NODE) return NULL_NODE;
+
+    using Entry = std::pair<float, int>;  // Distancia al cuadrado a la caja, nodo
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push({ DistanceSquared(nodes[root].box, point), root });
+
+    int best = NULL_NODE;
+    float bestDistance = maxDistance;
+    while (!open.empty()) {
+        auto [boxDistanceSquared, index] = open.top();
+        open.pop();
+        if (boxDistanceSquared > bestDistance * bestDistance) break;
+
+        const Node& node = nodes[index];
+        if (node.isLeaf()) {
+            float d = distance(index);
+            if (d < bestDistance) {
+                bestDistance = d;
+                best = index;
+            }
+        }
+        else {
+            open.push({ DistanceSquared(nodes[node.child1].box, point), node.child1 });
+            open.push({ DistanceSquared(nodes[node.child2].box, point), node.child2 });
+        }
+    }
+    return best;
+}
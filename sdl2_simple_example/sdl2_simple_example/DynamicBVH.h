@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "Frustum.h"
+
+// Jerarquía de volúmenes envolventes dinámica (árbol de AABBs). Cada hoja guarda una caja "gorda", algo más
+// grande que la real, para que los objetos que se mueven poco no tengan que reinsertarse. Las inserciones
+// eligen el hermano que menos superficie añade y el árbol se reequilibra con rotaciones, así que su
+// altura se mantiene logarítmica aunque los objetos entren y salgan.
+class DynamicBVH {
+public:
+    static const int NULL_NODE = -1;
+
+    DynamicBVH();
+
+    // Crea una hoja para una caja y devuelve su identificador
+    int CreateProxy(const AABB& box, void* userData);
+    void DestroyProxy(int proxy);
+
+    // Actualiza la caja de una hoja; solo se reinserta si se sale de su caja gorda (devuelve true en ese caso)
+    bool MoveProxy(int proxy, const AABB& box);
+
+    void* GetUserData(int proxy) const { return nodes[proxy].userData; }
+    const AABB& GetFatAABB(int proxy) const { return nodes[proxy].box; }
+
+    // Hojas cuya caja toca el frustum. Los subárboles que quedan enteros dentro se recorren sin más pruebas.
+    void QueryFrustum(const Frustum& frustum, const std::function<void(int proxy)>& callback) const;
+
+    // Hojas cuya caja se solapa con la dada
+    void QueryAABB(const AABB& box, const std::function<void(int proxy)>& callback) const;
+
+    // Hojas atravesadas por el rayo hasta maxDistance. El callback devuelve la nueva distancia máxima
+    // (su propio impacto, para podar lo que queda detrás, o la que recibió para seguir igual).
+    void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  const std::function<float(int proxy, float maxDistance)>& callback) const;
+
+    // Hoja más cercana a un punto según la distancia que calcula el callback (que debe ser >= que la
+    // distancia a la caja gorda); NULL_NODE si no hay ninguna a menos de maxDistance
+    int QueryNearest(const glm::vec3& point, float maxDistance, const std::function<float(int proxy)>& distance) const;
+
+    int GetHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+    size_t GetProxyCount() const { return proxyCount; }
+
+private:
+    struct Node {
+        AABB box;
+        void* userData = nullptr;
+        int parent = NULL_NODE;  // En los nodos libres, siguiente de la lista de libres
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+        int height = -1;         // 0 en las hojas, -1 en los nodos libres
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int node);
+    void ReplaceChild(int parent, int oldChild, int newChild);
+
+    std::vector<Node> nodes;
+    int root;
+    int freeList;
+    size_t proxyCount;
+};
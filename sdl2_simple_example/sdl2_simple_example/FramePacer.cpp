@@ -0,0 +1,117 @@
+#include "FramePacer.h"
+#include "Logger.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FramePacer::FramePacer() : frameStart(Clock::now()), deadline(Clock::now()) {}
+
+void FramePacer::SetMode(PacingMode newMode) {
+    int interval = 0;
+    if (newMode == PacingMode::VSYNC) interval = 1;
+    if (newMode == PacingMode::ADAPTIVE_VSYNC) interval = -1;
+
+    if (SDL_GL_SetSwapInterval(interval) != 0) {
+        if (newMode == PacingMode::ADAPTIVE_VSYNC) {
+            adaptiveSupported = false;
+            Logger::GetInstance().Log("Vsync adaptativo no disponible: se usa el vsync normal", WARNING);
+            newMode = PacingMode::VSYNC;
+            SDL_GL_SetSwapInterval(1);
+        }
+        else {
+            LOG_FORMAT(WARNING, "No se pudo cambiar el intervalo de intercambio: %s", SDL_GetError());
+        }
+    }
+
+    mode = newMode;
+    deadline = Clock::now();
+    frameTimeCount = 0;
+    nextFrameTime = 0;
+}
+
+void FramePacer::SetTargetFps(int fps) {
+    targetFps = std::max(fps, 1);
+}
+
+float FramePacer::BeginFrame() {
+    Clock::time_point now = Clock::now();
+    deltaTime = std::chrono::duration<float>(now - frameStart).count();
+    frameStart = now;
+
+    frameTimes[nextFrameTime] = deltaTime * 1000.0f;
+    nextFrameTime = (nextFrameTime + 1) % HISTORY_SIZE;
+    frameTimeCount = std::min(frameTimeCount + 1, HISTORY_SIZE);
+    return deltaTime;
+}
+
+void FramePacer::EndFrame() {
+    if (mode != PacingMode::LOW_LATENCY) return;
+
+    // Las fechas límite avanzan un periodo exacto cada frame, así que los errores de un frame no se acumulan.
+    // Si el frame se ha pasado de más de un periodo no se intenta recuperar: se parte de ahora.
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+    deadline += period;
+    Clock::time_point now = Clock::now();
+    if (deadline < now - period) {
+        deadline = now;
+        return;
+    }
+    WaitUntil(deadline);
+}
+
+// sleep_for despierta con un retraso que depende del sistema (hasta más de un milisegundo en Windows), así que se
+// duerme a tramos cortos mientras quede más margen que el peor retraso visto y el final se hace en espera activa
+void FramePacer::WaitUntil(Clock::time_point wakeUp) {
+    const std::chrono::duration<double> step(0.001);
+    while (true) {
+        Clock::time_point before = Clock::now();
+        std::chrono::duration<double> remaining = wakeUp - before;
+        if (remaining.count() <= sleepOvershoot + step.count()) break;
+
+        std::this_thread::sleep_for(step);
+        double overshoot = std::chrono::duration<double>(Clock::now() - before).count() - step.count();
+        // El margen se adapta al peor caso y se relaja despacio si el sistema mejora
+        sleepOvershoot = std::max(overshoot, sleepOvershoot * 0.995);
+    }
+
+    while (Clock::now() < wakeUp) {
+        std::this_thread::yield();
+    }
+}
+
+FrameTimingStats FramePacer::GetStats() const {
+    FrameTimingStats stats;
+    stats.samples = frameTimeCount;
+    if (frameTimeCount == 0) return stats;
+
+    // Dos pasadas sobre la ventana: la media y luego la varianza respecto a ella
+    double sum = 0.0;
+    stats.minMs = frameTimes[0];
+    stats.maxMs = frameTimes[0];
+    for (int i = 0; i < frameTimeCount; i++) {
+        sum += frameTimes[i];
+        stats.minMs = std::min(stats.minMs, frameTimes[i]);
+        stats.maxMs = std::max(stats.maxMs, frameTimes[i]);
+    }
+    double mean = sum / frameTimeCount;
+
+    double squares = 0.0;
+    for (int i = 0; i < frameTimeCount; i++) {
+        double offset = frameTimes[i] - mean;
+        squares += offset * offset;
+    }
+    stats.meanMs = float(mean);
+    stats.stdDevMs = float(std::sqrt(squares / frameTimeCount));
+    return stats;
+}
+
+const char* FramePacer::GetModeName(PacingMode mode) {
+    switch (mode) {
+    case PacingMode::VSYNC: return "VSync";
+    case PacingMode::ADAPTIVE_VSYNC: return "Adaptive VSync";
+    case PacingMode::UNCAPPED: return "Uncapped";
+    case PacingMode::LOW_LATENCY: return "Low Latency";
+    }
+    return "";
+}
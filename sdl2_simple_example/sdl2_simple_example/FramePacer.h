@@ -0,0 +1,73 @@
+#pragma once
+#include <chrono>
+
+enum class PacingMode {
+    VSYNC,           // Intervalo de intercambio 1: el driver bloquea en el swap hasta el refresco
+    ADAPTIVE_VSYNC,  // Intervalo -1: como VSYNC, pero si un frame llega tarde se presenta sin esperar
+    UNCAPPED,        // Sin límite, para medir
+    LOW_LATENCY      // Sin vsync; se espera hasta la fecha límite del frame durmiendo y acabando en espera activa
+};
+
+// Resumen de los tiempos de frame recientes, en milisegundos
+struct FrameTimingStats {
+    int samples = 0;
+    float meanMs = 0.0f;
+    float stdDevMs = 0.0f;  // Raíz de la varianza: lo estable que es el ritmo
+    float minMs = 0.0f;
+    float maxMs = 0.0f;
+};
+
+// Único responsable del ritmo de los frames y de medir su duración: el bucle principal llama a BeginFrame al
+// empezar cada frame y a EndFrame tras el swap. El resto del código lee de aquí el deltaTime.
+class FramePacer {
+public:
+    static FramePacer& GetInstance() {
+        static FramePacer instance;
+        return instance;
+    }
+
+    // Necesita el contexto de OpenGL activo (fija el intervalo de intercambio)
+    void SetMode(PacingMode mode);
+    PacingMode GetMode() const { return mode; }
+    // false si el driver rechazó el vsync adaptativo y se está usando el normal
+    bool IsAdaptiveVsyncSupported() const { return adaptiveSupported; }
+
+    // Frames por segundo del modo LOW_LATENCY
+    void SetTargetFps(int fps);
+    int GetTargetFps() const { return targetFps; }
+
+    // Devuelve el tiempo desde el BeginFrame anterior, en segundos
+    float BeginFrame();
+    void EndFrame();
+
+    float GetDeltaTime() const { return deltaTime; }
+    FrameTimingStats GetStats() const;
+
+    static const char* GetModeName(PacingMode mode);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacer();
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    void WaitUntil(Clock::time_point deadline);
+
+    static const int HISTORY_SIZE = 240;
+
+    PacingMode mode = PacingMode::VSYNC;
+    bool adaptiveSupported = true;
+    int targetFps = 60;
+
+    Clock::time_point frameStart;
+    Clock::time_point deadline;
+    float deltaTime = 0.0f;
+
+    // Lo más que se ha pasado sleep_for al despertar; por debajo de este margen ya no se duerme
+    double sleepOvershoot = 0.002;
+
+    float frameTimes[HISTORY_SIZE] = {};  // Milisegundos, en anillo
+    int frameTimeCount = 0;
+    int nextFrameTime = 0;
+};
@@ -0,0 +1,111 @@
+#include "FrameTimeHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+FrameTimeHistory::FrameTimeHistory() : frameTimes(), recentHitches() {
+    scratch.reserve(CAPACITY);
+}
+
+void FrameTimeHistory::Add(float ms) {
+    frameTimes[next] = ms;
+    next = (next + 1) % CAPACITY;
+    count = std::min(count + 1, CAPACITY);
+
+    if (ms > budgetMs) {
+        recentHitches[nextHitch] = { totalFrames, ms };
+        nextHitch = (nextHitch + 1) % RECENT_HITCHES;
+        recentHitchCount = std::min(recentHitchCount + 1, RECENT_HITCHES);
+        totalHitches++;
+    }
+    totalFrames++;
+}
+
+void FrameTimeHistory::Clear() {
+    count = 0;
+    next = 0;
+    totalHitches = 0;
+    recentHitchCount = 0;
+    nextHitch = 0;
+}
+
+float FrameTimeHistory::At(int age) const {
+    return frameTimes[(GetOffset() + age) % CAPACITY];
+}
+
+float FrameTimeHistory::GetLatest() const {
+    return count > 0 ? frameTimes[(next + CAPACITY - 1) % CAPACITY] : 0.0f;
+}
+
+// nth_element deja a la izquierda todo lo menor, así que cada percentil se busca solo en lo que queda a la
+// derecha del anterior: en total es lineal, sin ordenar la ventana
+FrameTimePercentiles FrameTimeHistory::ComputePercentiles() const {
+    FrameTimePercentiles result;
+    result.samples = count;
+    if (count == 0) return result;
+
+    scratch.assign(frameTimes, frameTimes + count);
+    auto rank = [this](float percentile) {
+        int index = int(std::ceil(percentile * count)) - 1;
+        return std::clamp(index, 0, count - 1);
+    };
+
+    auto begin = scratch.begin();
+    auto p50 = begin + rank(0.50f);
+    auto p95 = begin + rank(0.95f);
+    auto p99 = begin + rank(0.99f);
+    std::nth_element(begin, p50, scratch.end());
+    std::nth_element(p50, p95, scratch.end());
+    std::nth_element(p95, p99, scratch.end());
+
+    result.p50 = *p50;
+    result.p95 = *p95;
+    result.p99 = *p99;
+    result.maxMs = *std::max_element(p99, scratch.end());
+    return result;
+}
+
+void FrameTimeHistory::BuildHistogram(float* bins, int binCount, float maxMs) const {
+    std::fill(bins, bins + binCount, 0.0f);
+    if (binCount <= 0 || maxMs <= 0.0f) return;
+
+    float scale = binCount / maxMs;
+    for (int i = 0; i < count; i++) {
+        int bin = std::min(int(frameTimes[i] * scale), binCount - 1);
+        bins[std::max(bin, 0)] += 1.0f;
+    }
+}
+
+void FrameTimeHistory::SetBudgetMs(float ms) {
+    budgetMs = std::max(ms, 0.1f);
+}
+
+int FrameTimeHistory::GetHitchCount() const {
+    int hitches = 0;
+    for (int i = 0; i < count; i++) {
+        if (frameTimes[i] > budgetMs) hitches++;
+    }
+    return hitches;
+}
+
+std::vector<FrameHitch> FrameTimeHistory::GetRecentHitches() const {
+    std::vector<FrameHitch> hitches;
+    hitches.reserve(recentHitchCount);
+    for (int i = 1; i <= recentHitchCount; i++) {
+        hitches.push_back(recentHitches[(nextHitch + RECENT_HITCHES - i) % RECENT_HITCHES]);
+    }
+    return hitches;
+}
+
+bool FrameTimeHistory::ExportCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "frame,ms,hitch\n";
+    uint64_t firstFrame = totalFrames - uint64_t(count);
+    for (int age = 0; age < count; age++) {
+        float ms = At(age);
+        out << firstFrame + age << ',' << ms << ',' << (ms > budgetMs ? 1 : 0) << '\n';
+    }
+    return bool(out);
+}
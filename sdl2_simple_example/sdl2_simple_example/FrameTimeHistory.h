@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Percentiles de los tiempos guardados, en milisegundos (por rango: el p95 es el frame por debajo del cual
+// queda el 95% de la ventana)
+struct FrameTimePercentiles {
+    int samples = 0;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float maxMs = 0.0f;
+};
+
+// Un frame que se pasó del presupuesto
+struct FrameHitch {
+    uint64_t frame;
+    float ms;
+};
+
+// Anillo de capacidad fija con el tiempo de cada frame, sin promediar, para que los tirones se vean. Añadir es
+// O(1) y no reserva memoria; los percentiles y el histograma se calculan al pedirlos.
+class FrameTimeHistory {
+public:
+    static constexpr int CAPACITY = 1024;
+    static constexpr int RECENT_HITCHES = 8;
+
+    FrameTimeHistory();
+
+    void Add(float ms);
+    void Clear();
+
+    int GetCount() const { return count; }
+    uint64_t GetTotalFrames() const { return totalFrames; }
+
+    // Para ImGui::PlotLines: el bloque completo y la posición del más antiguo
+    const float* GetData() const { return frameTimes; }
+    int GetOffset() const { return count < CAPACITY ? 0 : next; }
+    float GetLatest() const;
+
+    FrameTimePercentiles ComputePercentiles() const;
+    // Reparte la ventana en binCount intervalos iguales entre 0 y maxMs; lo que pase de maxMs va al último
+    void BuildHistogram(float* bins, int binCount, float maxMs) const;
+
+    void SetBudgetMs(float ms);
+    float GetBudgetMs() const { return budgetMs; }
+    int GetHitchCount() const;                   // En la ventana actual
+    uint64_t GetTotalHitches() const { return totalHitches; }
+    // Los tirones más recientes, del más nuevo al más antiguo
+    std::vector<FrameHitch> GetRecentHitches() const;
+
+    // Una fila por frame de la ventana: número de frame, milisegundos y si fue un tirón
+    bool ExportCsv(const std::string& path) const;
+
+private:
+    float At(int age) const;  // 0 es el más antiguo de la ventana
+
+    float frameTimes[CAPACITY];
+    int count = 0;
+    int next = 0;
+    uint64_t totalFrames = 0;
+
+    float budgetMs = 1000.0f / 60.0f;
+    uint64_t totalHitches = 0;
+    FrameHitch recentHitches[RECENT_HITCHES];
+    int recentHitchCount = 0;
+    int nextHitch = 0;
+
+    mutable std::vector<float> scratch;  // Copia para los percentiles, reutilizada entre llamadas
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+// Pirámide de visión como seis planos (normales hacia dentro) extraídos de la matriz proyección * vista
+class Frustum {
+public:
+    // Con prefijo: NEAR y FAR son macros en las cabeceras de Windows
+    enum Plane { PLANE_LEFT, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR, PLANE_COUNT };
+    enum Result { OUTSIDE, INTERSECTS, INSIDE };
+
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& viewProjection) { update(viewProjection); }
+
+    // Cada plano es una combinación de filas de la matriz (Gribb y Hartmann); glm guarda por columnas
+    void update(const glm::mat4& m) {
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        planes[PLANE_LEFT] = row3 + row0;
+        planes[PLANE_RIGHT] = row3 - row0;
+        planes[PLANE_BOTTOM] = row3 + row1;
+        planes[PLANE_TOP] = row3 - row1;
+        planes[PLANE_NEAR] = row3 + row2;
+        planes[PLANE_FAR] = row3 - row2;
+
+        for (glm::vec4& plane : planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+    }
+
+    bool intersects(const BoundingSphere& sphere) const {
+        for (const glm::vec4& plane : planes) {
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) return false;
+        }
+        return true;
+    }
+
+    // Para cada plano basta con probar la esquina de la caja que está más adentro (el vértice positivo)
+    bool intersects(const AABB& box) const {
+        for (const glm::vec4& plane : planes) {
+            glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x,
+                               plane.y >= 0.0f ? box.max.y : box.min.y,
+                               plane.z >= 0.0f ? box.max.z : box.min.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) return false;
+        }
+        return true;
+    }
+
+    // Como intersects, pero distingue las cajas que quedan enteras dentro (su vértice negativo tampoco sale)
+    Result classify(const AABB& box) const {
+        Result result = INSIDE;
+        for (const glm::vec4& plane : planes) {
+            glm::vec3 normal(plane);
+            glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x,
+                               plane.y >= 0.0f ? box.max.y : box.min.y,
+                               plane.z >= 0.0f ? box.max.z : box.min.z);
+            if (glm::dot(normal, positive) + plane.w < 0.0f) return OUTSIDE;
+
+            glm::vec3 negative(plane.x >= 0.0f ? box.min.x : box.max.x,
+                               plane.y >= 0.0f ? box.min.y : box.max.y,
+                               plane.z >= 0.0f ? box.min.z : box.max.z);
+            if (glm::dot(normal, negative) + plane.w < 0.0f) result = INTERSECTS;
+        }
+        return result;
+    }
+
+    const glm::vec4& getPlane(Plane plane) const { return planes[plane]; }
+
+private:
+    glm::vec4 planes[PLANE_COUNT];
+};
@@ -3,13 +3,21 @@
 #include <unordered_set>
 #include <iostream>
 #include <cfloat>
+#include <cmath>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include "MeshCache.h"
+#include "SpatialIndex.h"
+#include "TransformSystem.h"
+#include "RenderQueue.h"
+#include "Logger.h"
 
 // Inicializaci�n del contador est�tico para los IDs �nicos
 int GameObject::nextId = 0;
 std::unordered_set<std::string> GameObject::generatedNames;
 
 GameObject::GameObject(const std::string& customName)
-    : id(++nextId), scale(1.0f, 1.0f, 1.0f) { // Asigna una escala por defecto de (1,1,1)
+    : id(++nextId), transformHandle(TransformSystem::GetInstance().Create(this)) { // Escala (1,1,1) por defecto
     // Si no se proporciona un nombre, generamos uno �nico
     name = customName.empty() ? generateUniqueName() : customName;
 }
@@ -17,6 +25,20 @@ GameObject::GameObject(const std::string& customName)
 
 GameObject::~GameObject() {
     generatedNames.erase(name); // Al destruir el objeto, eliminamos su nombre del conjunto
+
+    // Los hijos pasan a ser raíces con la misma posición en el mundo
+    setParent(nullptr, false);
+    while (!children.empty()) {
+        GameObject* child = children.back();
+        if (!child->setParent(nullptr, true)) {
+            child->setParent(nullptr, false);  // Escala nula en el mundo: no hay transformación local equivalente
+        }
+    }
+    TransformSystem::GetInstance().Destroy(transformHandle);
+
+    if (indexProxy != -1 || indexMovedSlot != -1) {
+        SpatialIndex::GetInstance().Remove(this);
+    }
 }
 
 const std::string& GameObject::getName() const {
@@ -34,49 +56,59 @@ void GameObject::setName(const std::string& newName) {
 
 bool GameObject::loadModel(const std::string& path) {
     bool result = modelLoader.loadModel(path);
+    markBoundsDirty();
     return result;
 }
 
-void GameObject::draw() {
+void GameObject::setMesh(std::shared_ptr<const MeshResource> mesh) {
+    modelLoader.setMesh(std::move(mesh));
+    markBoundsDirty();
+}
+
+void GameObject::markBoundsDirty() {
+    boundsDirty = true;
+    SpatialIndex::GetInstance().MarkMoved(this);
+}
+
+void GameObject::draw(RenderStateCache& state) {
     glPushMatrix();
-    glTranslatef(position.x, position.y, position.z);
-    glRotatef(rotation.x, 1.0f, 0.0f, 0.0f);
-    glRotatef(rotation.y, 0.0f, 1.0f, 0.0f);
-    glRotatef(rotation.z, 0.0f, 0.0f, 1.0f);
-    glScalef(scale.x, scale.y, scale.z);
-    material.use(); // Aplica el material antes de dibujar el modelo
+    glMultMatrixf(&getTransform()[0][0]);
+    material.use(state); // Aplica el material antes de dibujar el modelo (el Renderer restablece el estado al final)
 
     modelLoader.drawModel();
     glPopMatrix();
-
-    // Restablecer el estado de OpenGL
-    glDisable(GL_TEXTURE_2D);
-    glColor3f(1.0f, 1.0f, 1.0f); // Restablecer el color a blanco
 }
 
 // M�todos de transformaci�n
 void GameObject::setPosition(const glm::vec3& pos) {
-    position = pos;
+    // El inspector lo llama cada frame: solo se invalidan los volúmenes si el valor cambia de verdad
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    if (pos == transforms.GetPosition(transformHandle)) return;
+    transforms.SetPosition(transformHandle, pos);
 }
 
 glm::vec3 GameObject::getPosition() const {
-    return position;
+    return TransformSystem::GetInstance().GetPosition(transformHandle);
 }
 
 void GameObject::setScale(const glm::vec3& scl) {
-    scale = scl;
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    if (scl == transforms.GetScale(transformHandle)) return;
+    transforms.SetScale(transformHandle, scl);
 }
 
 glm::vec3 GameObject::getScale() const {
-    return scale;
+    return TransformSystem::GetInstance().GetScale(transformHandle);
 }
 
 void GameObject::setRotation(const glm::vec3& rot) {
-    rotation = rot;
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    if (rot == transforms.GetRotation(transformHandle)) return;
+    transforms.SetRotation(transformHandle, rot);
 }
 
 glm::vec3 GameObject::getRotation() const {
-    return rotation;
+    return TransformSystem::GetInstance().GetRotation(transformHandle);
 }
 
 // M�todos de material
@@ -103,19 +135,113 @@ std::string GameObject::generateUniqueName() {
 }
 
 glm::vec3 GameObject::getMeshSize() const {
-    const aiScene* scene = modelLoader.getScene();
-    glm::vec3 minBound(FLT_MAX), maxBound(-FLT_MAX);
-
-    if (scene) {
-        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-            aiMesh* mesh = scene->mMeshes[i];
-            for (unsigned int j = 0; j < mesh->mNumVertices; ++j) {
-                aiVector3D vertex = mesh->mVertices[j];
-                minBound = glm::min(minBound, glm::vec3(vertex.x, vertex.y, vertex.z));
-                maxBound = glm::max(maxBound, glm::vec3(vertex.x, vertex.y, vertex.z));
-            }
+    const std::shared_ptr<const MeshResource>& mesh = modelLoader.getMesh();
+    return mesh && mesh->getAABB().isValid() ? mesh->getAABB().getSize() : glm::vec3(0.0f);
+}
+
+const glm::mat4& GameObject::getTransform() const {
+    return TransformSystem::GetInstance().GetWorldMatrix(transformHandle);
+}
+
+bool GameObject::isDescendantOf(const GameObject* ancestor) const {
+    for (const GameObject* current = parent; current; current = current->parent) {
+        if (current == ancestor) return true;
+    }
+    return false;
+}
+
+bool GameObject::setParent(GameObject* newParent, bool keepWorldTransform) {
+    if (newParent == parent) return true;
+    if (newParent == this || (newParent && newParent->isDescendantOf(this))) {
+        Logger::GetInstance().Log("Cannot parent " + name + " to one of its descendants", WARNING);
+        return false;
+    }
+
+    if (keepWorldTransform) {
+        // Las matrices de mundo solo se recalculan en UpdateTransforms; un setter llamado antes en el mismo frame
+        // las dejaría desfasadas
+        UpdateTransforms();
+
+        // Transformación local que deja el objeto donde estaba: T * Rx * Ry * Rz * S, como en TransformSystem
+        glm::mat4 local = newParent ? glm::inverse(newParent->getTransform()) * getTransform() : getTransform();
+        glm::vec3 newScale(glm::length(glm::vec3(local[0])), glm::length(glm::vec3(local[1])), glm::length(glm::vec3(local[2])));
+        if (newScale.x <= 0.0f || newScale.y <= 0.0f || newScale.z <= 0.0f) {
+            Logger::GetInstance().Log("Cannot parent " + name + " without moving it: its scale in the new parent would be zero", WARNING);
+            return false;
         }
+        // Columnas de la rotación Rx * Ry * Rz; cerca de los 90 grados en Y el giro en Z se pasa a X
+        glm::vec3 axisX = glm::vec3(local[0]) / newScale.x;
+        glm::vec3 axisY = glm::vec3(local[1]) / newScale.y;
+        glm::vec3 axisZ = glm::vec3(local[2]) / newScale.z;
+        float sinY = glm::clamp(axisZ.x, -1.0f, 1.0f);
+        glm::vec3 angles;
+        angles.y = std::asin(sinY);
+        if (std::abs(sinY) < 0.9999f) {
+            angles.x = std::atan2(-axisZ.y, axisZ.z);
+            angles.z = std::atan2(-axisY.x, axisX.x);
+        }
+        else {
+            angles.x = std::atan2(axisY.z, axisY.y);
+            angles.z = 0.0f;
+        }
+        setPosition(glm::vec3(local[3]));
+        setRotation(glm::degrees(angles));
+        setScale(newScale);
+    }
+
+    if (parent) {
+        parent->children.erase(std::find(parent->children.begin(), parent->children.end(), this));
+    }
+    parent = newParent;
+    if (parent) {
+        parent->children.push_back(this);
     }
+    TransformSystem::GetInstance().SetParent(transformHandle, parent ? parent->transformHandle : TransformSystem::NULL_HANDLE);
+    return true;
+}
+
+void GameObject::UpdateTransforms() {
+    // Se reutiliza entre frames para no reservar memoria cada vez
+    static std::vector<int> changed;
+    changed.clear();
+
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    transforms.Update(changed);
+    for (int handle : changed) {
+        transforms.GetOwner(handle)->markBoundsDirty();
+    }
+}
+
+const AABB& GameObject::getWorldAABB() const {
+    updateWorldBounds();
+    return worldAABB;
+}
+
+const BoundingSphere& GameObject::getWorldSphere() const {
+    updateWorldBounds();
+    return worldSphere;
+}
+
+bool GameObject::raycast(const Ray& ray, float maxDistance, float& hitDistance) const {
+    const std::shared_ptr<const MeshResource>& mesh = modelLoader.getMesh();
+    if (!mesh) return false;
+
+    glm::vec3 inverseDirection = 1.0f / ray.direction;
+    if (RayBoxEnter(getWorldAABB(), ray.origin, inverseDirection, maxDistance) < 0.0f) return false;
+
+    // El rayo pasa al espacio del asset con la inversa de la matriz que usa draw(); como la dirección no se
+    // normaliza, la distancia del impacto sigue valiendo en el espacio de mundo
+    glm::mat4 toMesh = glm::inverse(glm::scale(getTransform(), glm::vec3(ModelLoader::MODEL_SCALE)));
+    return mesh->raycast(ray.transformed(toMesh), maxDistance, hitDistance);
+}
+
+void GameObject::updateWorldBounds() const {
+    const MeshResource* mesh = modelLoader.getMesh().get();
+    if (!boundsDirty && mesh == boundsMesh) return;
 
-    return maxBound - minBound;
+    glm::mat4 transform = getTransform();
+    worldAABB = modelLoader.getLocalAABB().transformed(transform);
+    worldSphere = modelLoader.getLocalSphere().transformed(transform);
+    boundsMesh = mesh;
+    boundsDirty = false;
 }
\ No newline at end of file
@@ -2,11 +2,16 @@
 #define GAMEOBJECT_H
 
 #include <glm/glm.hpp>
+#include "Bounds.h"
 #include "ModelLoader.h"
 #include "Material.h"
 #include <string>
+#include <vector>
+#include <memory>
 #include <unordered_set>
 
+class RenderStateCache;
+
 class GameObject {
 public:
     // Constructor con nombre opcional. Si no se proporciona, genera uno único.
@@ -18,9 +23,9 @@ public:
 
     // Métodos para cargar y crear modelos
     bool loadModel(const std::string& path);
-    void draw();
+    void draw(RenderStateCache& state);
 
-    // Métodos de transformación
+    // Métodos de transformación (relativos al padre)
     void setPosition(const glm::vec3& position);
     glm::vec3 getPosition() const;
     void setScale(const glm::vec3& scale);
@@ -35,17 +40,60 @@ public:
     // Devuelve el ModelLoader asociado al GameObject
     ModelLoader& getModelLoader();
 
+    // Asigna una geometría ya subida y avisa al índice espacial de que han cambiado los volúmenes
+    void setMesh(std::shared_ptr<const MeshResource> mesh);
+
     // Método para obtener el tamaño de la malla (bounding box)
     glm::vec3 getMeshSize() const;
 
+    // Jerarquía. Los objetos siguen siendo propiedad de la lista de la escena; aquí solo se enlazan.
+    // Con keepWorldTransform la posición, rotación y escala locales se recalculan para que el objeto no se mueva.
+    // Devuelve false (y lo registra en el Logger) si newParent es el propio objeto o uno de sus descendientes, o si
+    // con keepWorldTransform la escala resultante tendría un eje nulo.
+    bool setParent(GameObject* newParent, bool keepWorldTransform = true);
+    GameObject* getParent() const { return parent; }
+    const std::vector<GameObject*>& getChildren() const { return children; }
+    bool isDescendantOf(const GameObject* ancestor) const;
+
+    // Recalcula en TransformSystem las matrices que han cambiado desde la última llamada y avisa al índice
+    // espacial de los objetos afectados. Mover un padre cuesta una pasada por su subárbol.
+    static void UpdateTransforms();
+
+    // Matriz de mundo, la misma que aplica draw(); válida tras UpdateTransforms
+    const glm::mat4& getTransform() const;
+    glm::vec3 getWorldPosition() const { return glm::vec3(getTransform()[3]); }
+
+    // Envolventes en espacio de mundo; solo se recalculan si cambia la transformación o la malla
+    const AABB& getWorldAABB() const;
+    const BoundingSphere& getWorldSphere() const;
+
+    // Distancia (en unidades de ray.direction) al triángulo más cercano que corta el rayo de mundo
+    bool raycast(const Ray& ray, float maxDistance, float& hitDistance) const;
+
 private:
     std::string name;     // Nombre del objeto
     ModelLoader modelLoader;
-    glm::vec3 position;   // Posición del objeto
-    glm::vec3 scale;      // Escala del objeto
-    glm::vec3 rotation;   // Rotación del objeto
+    int transformHandle;  // Posición, rotación, escala y matrices viven en TransformSystem
     Material material;    // Material del objeto
 
+    // Jerarquía, para recorrerla desde el editor (TransformSystem guarda la suya por handles)
+    GameObject* parent = nullptr;
+    std::vector<GameObject*> children;
+
+    // Caché de los volúmenes de mundo
+    mutable AABB worldAABB;
+    mutable BoundingSphere worldSphere;
+    mutable bool boundsDirty = true;
+    mutable const MeshResource* boundsMesh = nullptr; // Malla con la que se calcularon
+
+    void updateWorldBounds() const;
+    void markBoundsDirty();
+
+    // Estado en el índice espacial de la escena (lo gestiona SpatialIndex)
+    friend class SpatialIndex;
+    int indexProxy = -1;
+    int indexMovedSlot = -1;  // Posición en la lista de movidos pendientes, -1 si no está
+
     static int nextId;    // Contador estático de instancias
     static std::unordered_set<std::string> generatedNames; // Conjunto de nombres generados
     int id;               // ID único de cada GameObject
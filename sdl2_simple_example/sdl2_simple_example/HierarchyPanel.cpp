@@ -1,30 +1,79 @@
 #include "HierarchyPanel.h"
 #include <iostream>
+#include <algorithm>
 
-HierarchyPanel::HierarchyPanel() : selectedGameObject(nullptr) {}
+HierarchyPanel::HierarchyPanel() : selectedGameObject(nullptr), pendingChild(nullptr), pendingParent(nullptr) {}
 HierarchyPanel::~HierarchyPanel() {}
 
+void HierarchyPanel::RenderNode(GameObject* gameObject) {
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_DefaultOpen;
+    if (gameObject == selectedGameObject) flags |= ImGuiTreeNodeFlags_Selected;
+    if (gameObject->getChildren().empty()) flags |= ImGuiTreeNodeFlags_Leaf;
+
+    bool open = ImGui::TreeNodeEx(gameObject, flags, "%s", gameObject->getName().c_str());
+
+    // Si se selecciona un GameObject, lo guardamos como seleccionado
+    if (ImGui::IsItemClicked()) {
+        selectedGameObject = gameObject;
+        std::cout << "HierarchyPanel -> Selected GameObject: " << selectedGameObject->getName() << std::endl;
+    }
+
+    if (ImGui::BeginDragDropSource()) {
+        ImGui::SetDragDropPayload("GAMEOBJECT", &gameObject, sizeof(GameObject*));
+        ImGui::Text("%s", gameObject->getName().c_str());
+        ImGui::EndDragDropSource();
+    }
+    AcceptReparentDrop(gameObject);
+
+    if (open) {
+        for (GameObject* child : gameObject->getChildren()) {
+            RenderNode(child);
+        }
+        ImGui::TreePop();
+    }
+}
+
+void HierarchyPanel::AcceptReparentDrop(GameObject* newParent) {
+    if (!ImGui::BeginDragDropTarget()) return;
+    if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("GAMEOBJECT")) {
+        pendingChild = *static_cast<GameObject* const*>(payload->Data);
+        pendingParent = newParent;
+    }
+    ImGui::EndDragDropTarget();
+}
+
 void HierarchyPanel::Render(const std::vector<std::unique_ptr<GameObject>>& gameObjects) {
     ImGui::Begin("Hierarchy");
 
-    // Iterar sobre todos los GameObjects en la lista y mostrar su nombre
+    // Árbol a partir de las raíces; arrastrando un nodo sobre otro se cambia su padre
     for (const auto& gameObject : gameObjects) {
-        const std::string& name = gameObject->getName();
-        bool isSelected = (gameObject.get() == selectedGameObject);
-
-        // Si se selecciona un GameObject, lo guardamos como seleccionado
-        if (ImGui::Selectable(name.c_str(), isSelected)) {
-            selectedGameObject = gameObject.get();
-            std::cout << "HierarchyPanel -> Selected GameObject: " << selectedGameObject->getName() << std::endl;
+        if (!gameObject->getParent()) {
+            RenderNode(gameObject.get());
         }
     }
 
+    // Soltar en el hueco que queda debajo del árbol convierte el objeto en raíz
+    ImVec2 freeSpace = ImGui::GetContentRegionAvail();
+    ImGui::Dummy(ImVec2(freeSpace.x, std::max(freeSpace.y, ImGui::GetFrameHeight())));
+    AcceptReparentDrop(nullptr);
+
     ImGui::End();
 
+    if (pendingChild) {
+        // Se aplica fuera del recorrido para no modificar las listas de hijos mientras se iteran
+        // Si no se puede, setParent ya avisa en el Logger
+        pendingChild->setParent(pendingParent);
+        pendingChild = nullptr;
+        pendingParent = nullptr;
+    }
+
     // Mostrar detalles del GameObject seleccionado en un panel de "Inspector"
     if (selectedGameObject) {
         ImGui::Begin("Inspector");
 
+        GameObject* parent = selectedGameObject->getParent();
+        ImGui::Text("Parent: %s", parent ? parent->getName().c_str() : "(none)");
+
         // Mostrar la posición con slider y campo de texto
         glm::vec3 position = selectedGameObject->getPosition();
         if (ImGui::SliderFloat3("Position", &position.x, -100.0f, 100.0f)) {
@@ -73,8 +122,7 @@ void HierarchyPanel::Render(const std::vector<std::unique_ptr<GameObject>>& game
             static bool showCheckeredTexture = false;
             if (ImGui::Checkbox("Show Checkered Texture", &showCheckeredTexture)) {
                 if (showCheckeredTexture) {
-                    unsigned int checkeredTexture = Material::generateCheckeredTexture(256, 256);
-                    material.setTexture(checkeredTexture);
+                    material.setTexture(TextureManager::GetInstance().GetCheckerTexture());
                 }
                 else {
                     material.loadTexture(material.getTexturePath());
@@ -88,24 +136,27 @@ void HierarchyPanel::Render(const std::vector<std::unique_ptr<GameObject>>& game
 
         // Mostrar información de la malla (si tiene malla)
         ModelLoader& modelLoader = selectedGameObject->getModelLoader(); // Ahora podemos acceder al ModelLoader
-        const aiScene* scene = modelLoader.getScene();
-        if (scene) {
+        if (modelLoader.getMeshCount() > 0) {
             ImGui::Text("Mesh Information:");
-            ImGui::Text("Number of Meshes: %d", scene->mNumMeshes);
+            ImGui::Text("Number of Meshes: %d", (int)modelLoader.getMeshCount());
 
-            if (ImGui::Button("Show Triangle Normals")) {
-                modelLoader.setShowTriangleNormals(!modelLoader.isShowingTriangleNormals()); // Toggle
+            if (ImGui::Button("Show Vertex Normals")) {
+                modelLoader.setShowVertexNormals(!modelLoader.isShowingVertexNormals()); // Toggle
             }
 
             if (ImGui::Button("Show Face Normals")) {
                 modelLoader.setShowFaceNormals(!modelLoader.isShowingFaceNormals()); // Toggle
             }
 
-            else {
-                ImGui::Text("No mesh loaded.");
+            float normalLength = modelLoader.getNormalLength();
+            if (ImGui::SliderFloat("Normal Length", &normalLength, 0.01f, 1.0f, "%.2f")) {
+                modelLoader.setNormalLength(normalLength);
             }
-
-            ImGui::End();
         }
+        else {
+            ImGui::Text("No mesh loaded.");
+        }
+
+        ImGui::End();
     }
 }
@@ -12,7 +12,15 @@ public:
     // Renderiza la lista de GameObjects y maneja la selecci�n
     void Render(const std::vector<std::unique_ptr<GameObject>>& gameObjects);
     GameObject* getSelectedGameObject() const { return selectedGameObject; }
+    void setSelectedGameObject(GameObject* gameObject) { selectedGameObject = gameObject; }
 
 private:
     GameObject* selectedGameObject;  // Puntero al GameObject actualmente seleccionado
+
+    // Cambio de padre pedido al soltar un nodo arrastrado; se aplica al terminar de dibujar el árbol
+    GameObject* pendingChild;
+    GameObject* pendingParent;
+
+    void RenderNode(GameObject* gameObject);
+    void AcceptReparentDrop(GameObject* newParent);
 };
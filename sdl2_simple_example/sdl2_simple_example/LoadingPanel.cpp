@@ -0,0 +1,55 @@
+#include "LoadingPanel.h"
+#include "AssetLoader.h"
+#include <filesystem>
+
+LoadingPanel::LoadingPanel() {}
+LoadingPanel::~LoadingPanel() {}
+
+static const char* GetStateName(LoadState state) {
+    switch (state) {
+    case LoadState::QUEUED:    return "Queued";
+    case LoadState::READING:   return "Reading";
+    case LoadState::UPLOADING: return "Uploading";
+    case LoadState::DONE:      return "Done";
+    case LoadState::FAILED:    return "Failed";
+    case LoadState::CANCELLED: return "Cancelled";
+    }
+    return "";
+}
+
+void LoadingPanel::Render() {
+    AssetLoader& loader = AssetLoader::GetInstance();
+    std::vector<LoadJobInfo> jobs = loader.GetJobs();
+    if (jobs.empty()) return;
+
+    ImGui::Begin("Loading");
+
+    ImGui::Text("Assets in queue: %d", (int)jobs.size());
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Cancel All")) {
+        loader.CancelAll();
+    }
+    ImGui::Separator();
+
+    for (const LoadJobInfo& job : jobs) {
+        ImGui::PushID((int)job.id);
+
+        std::string name = std::filesystem::path(job.path).filename().string();
+        ImGui::Text("%s (%s)", name.c_str(), GetStateName(job.state));
+        if (job.progress < 0.0f) {
+            // Barra indeterminada: ImGui la anima con un valor negativo que avanza con el tiempo
+            ImGui::ProgressBar(-1.0f * (float)ImGui::GetTime(), ImVec2(200, 0), "Reading...");
+        }
+        else {
+            ImGui::ProgressBar(job.progress, ImVec2(200, 0));
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Cancel")) {
+            loader.Cancel(job.id);
+        }
+
+        ImGui::PopID();
+    }
+
+    ImGui::End();
+}
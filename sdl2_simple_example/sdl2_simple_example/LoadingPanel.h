@@ -0,0 +1,11 @@
+#pragma once
+#include "imgui.h"
+
+class LoadingPanel {
+public:
+    LoadingPanel();
+    ~LoadingPanel();
+
+    // Muestra el progreso de los assets en cola; solo aparece mientras haya cargas pendientes
+    void Render();
+};
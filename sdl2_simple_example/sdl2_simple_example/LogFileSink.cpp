@@ -0,0 +1,123 @@
+#include "LogFileSink.h"
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static const char* GetTypeName(LogType type) {
+    switch (type) {
+    case INFO:    return "INFO";
+    case WARNING: return "WARNING";
+    case INTRO:   return "INTRO";
+    }
+    return "";
+}
+
+LogFileSink::LogFileSink(const std::string& directory, const std::string& baseName, size_t maxFileBytes, int maxFiles)
+    : directory(directory), baseName(baseName), maxFileBytes(maxFileBytes), maxFiles(maxFiles) {
+    thread = std::thread(&LogFileSink::Run, this);
+}
+
+LogFileSink::~LogFileSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void LogFileSink::Write(std::vector<LogRecord>& batch) {
+    if (batch.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.empty()) {
+            pending.swap(batch);
+        }
+        else {
+            pending.insert(pending.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+        }
+    }
+    batch.clear();
+    wake.notify_one();
+}
+
+void LogFileSink::Run() {
+    std::vector<LogRecord> writing;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty() && stopping) break;
+            writing.swap(pending);
+        }
+
+        // El disco se toca sin el mutex: quien entrega mensajes nunca espera a una escritura
+        if (!file.is_open()) OpenFile();
+        for (const LogRecord& message : writing) {
+            WriteMessage(message);
+        }
+        file.flush();
+        writing.clear();
+    }
+}
+
+void LogFileSink::WriteMessage(const LogRecord& message) {
+    if (!file.is_open()) return;
+
+    std::time_t seconds = std::chrono::system_clock::to_time_t(message.time);
+    std::tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    int millis = int(std::chrono::duration_cast<std::chrono::milliseconds>(message.time.time_since_epoch()).count() % 1000);
+
+    char prefix[48];
+    int length = snprintf(prefix, sizeof(prefix), "%04d-%02d-%02d %02d:%02d:%02d.%03d [%s] ", local.tm_year + 1900,
+                          local.tm_mon + 1, local.tm_mday, local.tm_hour, local.tm_min, local.tm_sec, millis, GetTypeName(message.type));
+    file.write(prefix, length);
+    size_t textLength = message.Format(formatBuffer, sizeof(formatBuffer));
+    file.write(formatBuffer, std::streamsize(textLength));
+    if (message.repeat > 1) {
+        char repeat[24];
+        int repeatLength = snprintf(repeat, sizeof(repeat), " (x%u)", message.repeat);
+        file.write(repeat, repeatLength);
+        textLength += size_t(repeatLength);
+    }
+    file << '\n';
+    fileBytes += size_t(length) + textLength + 1;
+
+    if (fileBytes >= maxFileBytes) {
+        Rotate();
+    }
+}
+
+std::string LogFileSink::GetFilePath(int index) const {
+    std::string name = index == 0 ? baseName + ".log" : baseName + "." + std::to_string(index) + ".log";
+    return (fs::path(directory) / name).string();
+}
+
+void LogFileSink::Rotate() {
+    file.close();
+
+    std::error_code error;
+    fs::remove(GetFilePath(maxFiles - 1), error);
+    for (int i = maxFiles - 2; i >= 0; i--) {
+        fs::rename(GetFilePath(i), GetFilePath(i + 1), error);
+    }
+    OpenFile();
+}
+
+void LogFileSink::OpenFile() {
+    std::error_code error;
+    fs::create_directories(directory, error);
+
+    // Cada ejecución continúa el fichero actual; la rotación decide cuándo empezar otro
+    std::string path = GetFilePath(0);
+    fileBytes = size_t(fs::file_size(path, error));
+    if (error) fileBytes = 0;
+    file.open(path, std::ios::out | std::ios::app);
+}
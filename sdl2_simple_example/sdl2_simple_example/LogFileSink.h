@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LogRecord.h"
+
+// Escribe los mensajes en disco desde su propio hilo. Los ficheros rotan al pasar de maxFileBytes:
+// base.log pasa a base.1.log, base.1.log a base.2.log... y se conservan maxFiles en total. Los mensajes se
+// formatean aquí, fuera del hilo principal.
+class LogFileSink {
+public:
+    LogFileSink(const std::string& directory, const std::string& baseName, size_t maxFileBytes, int maxFiles);
+    ~LogFileSink();  // Escribe lo pendiente y para el hilo
+
+    LogFileSink(const LogFileSink&) = delete;
+    LogFileSink& operator=(const LogFileSink&) = delete;
+
+    // Entrega un lote al hilo de escritura; solo retiene el mutex para mover los mensajes
+    void Write(std::vector<LogRecord>& batch);
+
+private:
+    void Run();
+    void WriteMessage(const LogRecord& message);
+    void Rotate();
+    void OpenFile();
+    std::string GetFilePath(int index) const;
+
+    std::string directory;
+    std::string baseName;
+    size_t maxFileBytes;
+    int maxFiles;
+
+    std::ofstream file;
+    size_t fileBytes = 0;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<LogRecord> pending;
+    char formatBuffer[4096];
+    bool stopping = false;
+    std::thread thread;
+};
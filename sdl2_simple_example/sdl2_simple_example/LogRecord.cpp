@@ -0,0 +1,170 @@
+#include "LogRecord.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+static std::atomic<const char*> formats[LogFormats::MAX_FORMATS] = { { "%s" } };
+static std::atomic<uint32_t> formatCount{ 1 };
+static std::mutex registerMutex;
+
+uint32_t LogFormats::Register(const char* format) {
+    // Cada llamada la hace el inicializador de un static local, así que solo ocurre una vez por punto de registro
+    std::lock_guard<std::mutex> lock(registerMutex);
+    uint32_t id = formatCount.load(std::memory_order_relaxed);
+    if (id >= MAX_FORMATS) return TEXT;
+
+    formats[id].store(format, std::memory_order_release);
+    formatCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+const char* LogFormats::Get(uint32_t id) {
+    const char* format = id < MAX_FORMATS ? formats[id].load(std::memory_order_acquire) : nullptr;
+    return format ? format : "%s";
+}
+
+bool LogRecord::SameMessage(const LogRecord& other) const {
+    return formatId == other.formatId && type == other.type && argBytes == other.argBytes &&
+        std::memcmp(GetArgs(), other.GetArgs(), argBytes) == 0;
+}
+
+namespace {
+    struct DecodedArg {
+        char tag = 0;
+        int64_t integer = 0;
+        uint64_t unsignedInteger = 0;
+        double real = 0.0;
+        const char* text = "";
+        uint32_t length = 0;
+    };
+
+    // Añade al texto con snprintf y se queda en el último byte útil si no cabe
+    struct Output {
+        char* out;
+        size_t capacity;
+        size_t length = 0;
+
+        template <typename... Args>
+        void Print(const char* format, Args... args) {
+            if (length + 1 >= capacity) return;
+            int written = snprintf(out + length, capacity - length, format, args...);
+            if (written > 0) length += std::min(size_t(written), capacity - length - 1);
+        }
+
+        void Append(const char* text, size_t count) {
+            count = std::min(count, capacity - length - 1);
+            std::memcpy(out + length, text, count);
+            length += count;
+        }
+    };
+}
+
+// Se recorre el formato y cada especificador se pasa a snprintf por separado con el argumento guardado,
+// cambiando su modificador de longitud por el del tipo en que se guardó (todo entero va como 64 bits)
+size_t LogRecord::Format(char* out, size_t capacity) const {
+    if (capacity == 0) return 0;
+
+    static const int MAX_ARGS = 16;
+    DecodedArg args[MAX_ARGS];
+    int argCount = 0;
+    const unsigned char* data = GetArgs();
+    const unsigned char* end = data + argBytes;
+    while (data < end && argCount < MAX_ARGS) {
+        DecodedArg& arg = args[argCount++];
+        arg.tag = char(*data);
+        if (arg.tag == 's') {
+            std::memcpy(&arg.length, data + 1, 4);
+            arg.text = reinterpret_cast<const char*>(data + 5);
+            data += 5 + arg.length;
+        }
+        else {
+            if (arg.tag == 'i') std::memcpy(&arg.integer, data + 1, 8);
+            if (arg.tag == 'u') std::memcpy(&arg.unsignedInteger, data + 1, 8);
+            if (arg.tag == 'f') std::memcpy(&arg.real, data + 1, 8);
+            data += 9;
+        }
+    }
+
+    Output output = { out, capacity };
+    const char* format = LogFormats::Get(formatId);
+    int nextArg = 0;
+    for (const char* c = format; *c && output.length + 1 < capacity; ) {
+        if (*c != '%') {
+            const char* literal = c;
+            while (*c && *c != '%') c++;
+            output.Append(literal, size_t(c - literal));
+            continue;
+        }
+        if (c[1] == '%') {
+            output.Append("%", 1);
+            c += 2;
+            continue;
+        }
+
+        // Banderas, anchura y precisión se conservan; el modificador de longitud se descarta
+        char spec[32] = "%";
+        size_t specLength = 1;
+        c++;
+        while (*c && std::strchr("-+ #0123456789.", *c) && specLength < sizeof(spec) - 4) spec[specLength++] = *c++;
+        while (*c && std::strchr("hlLqjzt", *c)) c++;
+        char conversion = *c ? *c++ : 's';
+
+        if (nextArg >= argCount) {
+            output.Append("<?>", 3);
+            continue;
+        }
+        const DecodedArg& arg = args[nextArg++];
+        bool isInteger = std::strchr("diouxXc", conversion) != nullptr;
+        bool isReal = std::strchr("fFeEgGaA", conversion) != nullptr;
+
+        if (arg.tag == 's') {
+            // El texto guardado no acaba en cero: la precisión lo limita a su longitud (o a la pedida, si es menor)
+            int precision = int(arg.length);
+            if (char* dot = std::strchr(spec, '.')) {
+                precision = std::min(precision, std::atoi(dot + 1));
+                specLength = size_t(dot - spec);
+            }
+            spec[specLength++] = '.';
+            spec[specLength++] = '*';
+            spec[specLength++] = 's';
+            spec[specLength] = 0;
+            output.Print(spec, precision, arg.text);
+        }
+        else if (isReal) {
+            spec[specLength++] = conversion;
+            spec[specLength] = 0;
+            double value = arg.tag == 'f' ? arg.real : arg.tag == 'i' ? double(arg.integer) : double(arg.unsignedInteger);
+            output.Print(spec, value);
+        }
+        else if (isInteger && conversion != 'c') {
+            spec[specLength++] = 'l';
+            spec[specLength++] = 'l';
+            spec[specLength++] = conversion;
+            spec[specLength] = 0;
+            bool isSigned = conversion == 'd' || conversion == 'i';
+            if (isSigned) {
+                long long value = arg.tag == 'i' ? arg.integer : arg.tag == 'u' ? (long long)arg.unsignedInteger : (long long)arg.real;
+                output.Print(spec, value);
+            }
+            else {
+                unsigned long long value = arg.tag == 'u' ? arg.unsignedInteger : arg.tag == 'i' ? (unsigned long long)arg.integer : (unsigned long long)arg.real;
+                output.Print(spec, value);
+            }
+        }
+        else if (conversion == 'c') {
+            spec[specLength++] = 'c';
+            spec[specLength] = 0;
+            output.Print(spec, int(arg.tag == 'u' ? arg.unsignedInteger : arg.integer));
+        }
+        else {
+            // Conversión desconocida (%p, %s con un número...): el valor con su formato natural
+            if (arg.tag == 'f') output.Print("%g", arg.real);
+            else if (arg.tag == 'u') output.Print("%llu", (unsigned long long)arg.unsignedInteger);
+            else output.Print("%lld", (long long)arg.integer);
+        }
+    }
+
+    out[output.length] = 0;
+    return output.length;
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+enum LogType {
+    INFO,
+    WARNING,
+    INTRO
+
+};
+
+static const int LOG_TYPE_COUNT = 3;
+
+// Tabla de cadenas de formato: cada punto del código que registra con LOG_FORMAT da de alta la suya una sola vez
+// y los mensajes solo guardan su índice. Las cadenas deben ser literales (no se copian).
+class LogFormats {
+public:
+    static constexpr uint32_t TEXT = 0;  // "%s": mensajes que ya llegan formateados
+    static constexpr uint32_t MAX_FORMATS = 4096;
+
+    static uint32_t Register(const char* format);
+    static const char* Get(uint32_t id);
+};
+
+// Mensaje del log sin formatear: el índice del formato y los argumentos en binario. Los argumentos van en el
+// propio registro si caben (no se reserva memoria) y solo los textos largos pasan a spilled. El texto final se
+// compone al mostrarlo o al escribirlo en disco.
+struct LogRecord {
+    static constexpr size_t INLINE_BYTES = 72;
+
+    std::chrono::system_clock::time_point time;
+    uint32_t formatId = LogFormats::TEXT;
+    uint32_t repeat = 1;                // Veces seguidas que se ha repetido el mismo mensaje
+    LogType type = INFO;
+    uint32_t argBytes = 0;
+    unsigned char inlineArgs[INLINE_BYTES];
+    std::string spilled;
+
+    template <typename... Args>
+    void Capture(LogType logType, uint32_t format, const Args&... args);
+
+    // Mismo tipo, formato y argumentos
+    bool SameMessage(const LogRecord& other) const;
+
+    // Escribe el texto (terminado en cero, recortado si no cabe) y devuelve su longitud
+    size_t Format(char* out, size_t capacity) const;
+
+private:
+    const unsigned char* GetArgs() const { return spilled.empty() ? inlineArgs : reinterpret_cast<const unsigned char*>(spilled.data()); }
+};
+
+// Codificación de los argumentos: una etiqueta y el valor (i: entero con signo, u: sin signo, f: real,
+// s: longitud y bytes del texto)
+namespace LogArgs {
+    template <typename T>
+    size_t GetSize(const T&) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Tipo de argumento de log no soportado");
+        return 1 + 8;
+    }
+    // Un puntero nulo se registra como "(null)" en lugar de pasarlo a strlen
+    inline const char* TextOrNull(const char* text) { return text ? text : "(null)"; }
+
+    inline size_t GetSize(const char* text) { return 1 + 4 + std::strlen(TextOrNull(text)); }
+    inline size_t GetSize(char* text) { return GetSize(static_cast<const char*>(text)); }
+    inline size_t GetSize(const std::string& text) { return 1 + 4 + text.size(); }
+
+    inline unsigned char* WriteText(unsigned char* out, const char* text, uint32_t length) {
+        *out = 's';
+        std::memcpy(out + 1, &length, 4);
+        std::memcpy(out + 5, text, length);
+        return out + 5 + length;
+    }
+
+    template <typename T>
+    unsigned char* Write(unsigned char* out, const T& value) {
+        if constexpr (std::is_floating_point<T>::value) {
+            double number = double(value);
+            *out = 'f';
+            std::memcpy(out + 1, &number, 8);
+        }
+        else if constexpr (std::is_enum<T>::value || std::is_signed<T>::value) {
+            int64_t number = int64_t(value);
+            *out = 'i';
+            std::memcpy(out + 1, &number, 8);
+        }
+        else {
+            uint64_t number = uint64_t(value);
+            *out = 'u';
+            std::memcpy(out + 1, &number, 8);
+        }
+        return out + 9;
+    }
+    inline unsigned char* Write(unsigned char* out, const char* text) {
+        text = TextOrNull(text);
+        return WriteText(out, text, uint32_t(std::strlen(text)));
+    }
+    inline unsigned char* Write(unsigned char* out, char* text) { return Write(out, static_cast<const char*>(text)); }
+    inline unsigned char* Write(unsigned char* out, const std::string& text) { return WriteText(out, text.data(), uint32_t(text.size())); }
+}
+
+template <typename... Args>
+void LogRecord::Capture(LogType logType, uint32_t format, const Args&... args) {
+    time = std::chrono::system_clock::now();
+    formatId = format;
+    repeat = 1;
+    type = logType;
+
+    size_t size = (size_t(0) + ... + LogArgs::GetSize(args));
+    argBytes = uint32_t(size);
+    unsigned char* out = inlineArgs;
+    if (size > INLINE_BYTES) {
+        spilled.resize(size);
+        out = reinterpret_cast<unsigned char*>(&spilled[0]);
+    }
+    else {
+        spilled.clear();
+    }
+    ((out = LogArgs::Write(out, args)), ...);
+}
@@ -0,0 +1,60 @@
+#include "Logger.h"
+
+static const char* LOG_DIRECTORY = "Logs";
+static const size_t LOG_FILE_BYTES = 1024 * 1024;
+static const int LOG_FILES = 5;
+
+Logger::Logger() : fileSink(new LogFileSink(LOG_DIRECTORY, "engine", LOG_FILE_BYTES, LOG_FILES)) {
+    batch.reserve(256);
+}
+
+// Al salir se recoge lo que quede en la cola para que llegue al fichero
+Logger::~Logger() {
+    consolePanel = nullptr;
+    Flush();
+}
+
+void Logger::Log(const std::string& message, LogType type) {
+    LogFormat(type, LogFormats::TEXT, message);
+}
+
+void Logger::Log(const char* message, LogType type) {
+    LogFormat(type, LogFormats::TEXT, message);
+}
+
+void Logger::Push(LogRecord& record) {
+    if (!queue.TryPush(std::move(record))) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::Flush() {
+    // Los mensajes idénticos seguidos (el mismo aviso desde un bucle, por ejemplo) quedan en uno con su cuenta
+    LogRecord message;
+    while (queue.TryPop(message)) {
+        if (!batch.empty() && batch.back().SameMessage(message)) {
+            batch.back().repeat += message.repeat;
+            batch.back().time = message.time;
+        }
+        else {
+            batch.push_back(std::move(message));
+        }
+    }
+
+    // Los descartes se avisan en el propio log, una vez por tanda
+    uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != reportedDropped) {
+        static const uint32_t droppedFormat = LogFormats::Register("Cola del log llena: %llu mensajes descartados");
+        LogRecord notice;
+        notice.Capture(WARNING, droppedFormat, droppedNow - reportedDropped);
+        batch.push_back(std::move(notice));
+        reportedDropped = droppedNow;
+    }
+
+    if (consolePanel) {
+        for (const LogRecord& record : batch) {
+            consolePanel->Add(record);
+        }
+    }
+    fileSink->Write(batch);
+}
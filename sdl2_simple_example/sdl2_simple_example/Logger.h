@@ -1,9 +1,16 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <iostream>
+#include <atomic>
+#include <memory>
 #include "ConsolePanel.h"  // Incluye la clase ConsolePanel
+#include "LogFileSink.h"
+#include "LogRecord.h"
+#include "MpscQueue.h"
 
+// Logger asncrono: Log se puede llamar desde cualquier hilo y solo encola el mensaje en una cola sin bloqueos.
+// El hilo principal la vaca una vez por frame (Flush) hacia la consola y hacia el fichero, que se escribe en
+// su propio hilo. Los mensajes viajan sin formatear (LogRecord) y los repetidos seguidos se agrupan.
 class Logger {
 public:
     // Mtodo para obtener la instancia del logger
@@ -12,36 +19,54 @@ public:
         return instance;
     }
 
+    // Cualquier hilo. Si la cola est llena el mensaje se descarta (y se cuenta) en vez de esperar
+    void Log(const std::string& message, LogType type);
+    void Log(const char* message, LogType type);  // Sin construir un std::string para los literales
 
-    void Log(const std::string& message, LogType type) {
-
-        if (consolePanel) {
-            //std::cout << "ConsolePanel est asignado. Enviando log..." << std::endl;  // Debug
-            consolePanel->Log(message.c_str(), type);  // Pasa el mensaje a ConsolePanel
-        }
-        else {
-            //std::cout << "ConsolePanel no est asignado" << std::endl;  // Debug
-        }
+    // Para cdigo que se ejecuta cada frame o por objeto: guarda el formato y los argumentos en binario, sin
+    // reservar memoria ni formatear. Se usa a travs de LOG_FORMAT.
+    template <typename... Args>
+    void LogFormat(LogType type, uint32_t formatId, const Args&... args) {
+        LogRecord record;
+        record.Capture(type, formatId, args...);
+        Push(record);
     }
 
+    // Hilo principal, una vez por frame: reparte los mensajes encolados
+    void Flush();
 
-    // Establecer la instancia del ConsolePanel (se pasa en el WindowEditor)
-    void SetConsolePanel(ConsolePanel* panel) {
-        if (panel) {  // Verifica que no sea nullptr
-            consolePanel = panel;
-        }
-        else {
-            std::cerr << "Error: ConsolePanel no puede ser nullptr" << std::endl;
-        }
-    }
+    // Establecer la instancia del ConsolePanel (se pasa en el WindowEditor); nullptr la desconecta
+    void SetConsolePanel(ConsolePanel* panel) { consolePanel = panel; }
+
+    uint64_t GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
 
 private:
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    void Push(LogRecord& record);
+
     ConsolePanel* consolePanel = nullptr;  // ConsolePanel donde se mostrarn los mensajes
 
+    MpscQueue<LogRecord, QUEUE_CAPACITY> queue;
+    std::atomic<uint64_t> dropped{ 0 };
+    uint64_t reportedDropped = 0;
+    std::vector<LogRecord> batch;         // Reutilizado en cada Flush
+    std::unique_ptr<LogFileSink> fileSink;
+
     // Constructor privado para implementar el patrn Singleton
-    Logger() = default;
+    Logger();
+    ~Logger();
 
     // Desactivar la copia y asignacin
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 };
+
+// Registra un mensaje con formato de printf. La cadena debe ser un literal: se da de alta una vez por punto de
+// llamada y el texto se compone ms tarde, al mostrarlo o escribirlo.
+//     LOG_FORMAT(INFO, "Malla %s: %d vrtices", name, count);
+#define LOG_FORMAT(type, format, ...) \
+    do { \
+        static const uint32_t logFormatId = LogFormats::Register(format); \
+        Logger::GetInstance().LogFormat(type, logFormatId, ##__VA_ARGS__); \
+    } while (0)
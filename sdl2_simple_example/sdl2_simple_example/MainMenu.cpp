@@ -8,6 +8,7 @@
 #include "imgui_impl_opengl3.h"
 #include <SDL2/SDL.h>
 #include "GameObject.h"
+#include "AssetLoader.h"
 #include <memory>
 #include <vector>
 #include <iostream>
@@ -16,52 +17,36 @@
 extern std::vector<std::unique_ptr<GameObject>> gameObjects;
 extern Material defaultMaterial;
 
-void MainMenu::Render(bool& showConsole, bool& showConfig, bool& showHierarchy, bool& showInspector) {
+// Las primitivas se cargan en segundo plano y reciben el material por defecto al terminar
+static void spawnPrimitive(const char* path) {
+    AssetLoader::GetInstance().QueueModel(path, [](std::unique_ptr<GameObject> gameObject) {
+        gameObject->setMaterial(defaultMaterial);
+        gameObjects.push_back(std::move(gameObject));
+    });
+}
+
+void MainMenu::Render(bool& showConsole, bool& showConfig, bool& showHierarchy, bool& showInspector, bool& showProfiler) {
     if (ImGui::BeginMainMenuBar()) {
 
         if (ImGui::BeginMenu("File")) {
             if (ImGui::BeginMenu("Primitive")) {
                 if (ImGui::MenuItem("Cube")) {
-                    auto gameObject = std::make_unique<GameObject>();
-                    if (gameObject->loadModel("Assets/Primitives/Cube.fbx")) {
-                        gameObject->setMaterial(defaultMaterial);
-                        gameObjects.push_back(std::move(gameObject));
-                    }
+                    spawnPrimitive("Assets/Primitives/Cube.fbx");
                 }
                 if (ImGui::MenuItem("Sphere")) {
-                    auto gameObject = std::make_unique<GameObject>();
-                    if (gameObject->loadModel("Assets/Primitives/Sphere.fbx")) {
-                        gameObject->setMaterial(defaultMaterial);
-                        gameObjects.push_back(std::move(gameObject));
-                    }
+                    spawnPrimitive("Assets/Primitives/Sphere.fbx");
                 }
                 if (ImGui::MenuItem("Plane")) {
-                    auto gameObject = std::make_unique<GameObject>();
-                    if (gameObject->loadModel("Assets/Primitives/Plane.fbx")) {
-                        gameObject->setMaterial(defaultMaterial);
-                        gameObjects.push_back(std::move(gameObject));
-                    }
+                    spawnPrimitive("Assets/Primitives/Plane.fbx");
                 }
                 if (ImGui::MenuItem("Cylinder")) {
-                    auto gameObject = std::make_unique<GameObject>();
-                    if (gameObject->loadModel("Assets/Primitives/Cylinder.fbx")) {
-                        gameObject->setMaterial(defaultMaterial);
-                        gameObjects.push_back(std::move(gameObject));
-                    }
+                    spawnPrimitive("Assets/Primitives/Cylinder.fbx");
                 }
                 if (ImGui::MenuItem("Cone")) {
-                    auto gameObject = std::make_unique<GameObject>();
-                    if (gameObject->loadModel("Assets/Primitives/Cone.fbx")) {
-                        gameObject->setMaterial(defaultMaterial);
-                        gameObjects.push_back(std::move(gameObject));
-                    }
+                    spawnPrimitive("Assets/Primitives/Cone.fbx");
                 }
                 if (ImGui::MenuItem("Torus")) {
-                    auto gameObject = std::make_unique<GameObject>();
-                    if (gameObject->loadModel("Assets/Primitives/Torus.fbx")) {
-                        gameObject->setMaterial(defaultMaterial);
-                        gameObjects.push_back(std::move(gameObject));
-                    }
+                    spawnPrimitive("Assets/Primitives/Torus.fbx");
                 }
                 ImGui::EndMenu();
             }
@@ -85,6 +70,7 @@ void MainMenu::Render(bool& showConsole, bool& showConfig, bool& showHierarchy,
                 ImGui::MenuItem("Configuration", NULL, &showConfig);
                 ImGui::MenuItem("Hierarchy", NULL, &showHierarchy);
                 ImGui::MenuItem("Inspector", NULL, &showInspector);
+                ImGui::MenuItem("Profiler", NULL, &showProfiler);
                 ImGui::EndMenu();
             }
             ImGui::EndMenu();
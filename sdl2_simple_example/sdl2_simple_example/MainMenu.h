@@ -8,5 +8,5 @@ extern std::vector<std::unique_ptr<GameObject>> gameObjects;
 
 class MainMenu {
 public:
-    void Render(bool& showConsole, bool& showConfig, bool& showHierarchy, bool& showInspector);
+    void Render(bool& showConsole, bool& showConfig, bool& showHierarchy, bool& showInspector, bool& showProfiler);
 };
@@ -1,61 +1,35 @@
 #include <GL/glew.h>
 #include "Material.h"
-#include <IL/il.h>
-#include <IL/ilu.h>
-#include <IL/ilut.h>
+#include "RenderQueue.h"
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
-#include "Logger.h"
 
-Material::Material() : textureID(0), hasTexture(false), defaultColor(1.0f, 0.0f, 1.0f) {
-    ilInit();
-    iluInit();
-    ilutRenderer(ILUT_OPENGL);
-}
+Material::Material() : defaultColor(1.0f, 0.0f, 1.0f) {}
 
-Material::~Material() {
-    if (textureID) {
-        glDeleteTextures(1, &textureID);
-    }
-}
+Material::~Material() {}
 
 bool Material::loadTexture(const std::string& path) {
-    ilEnable(IL_ORIGIN_SET);
-    ilOriginFunc(IL_ORIGIN_LOWER_LEFT);
-
-    ILconst_string apath = reinterpret_cast<const ILconst_string>(path.c_str());
-    ILuint imageID;
-    ilGenImages(1, &imageID);
-    ilBindImage(imageID);
-
-    if (!ilLoadImage(apath)) {
-        ILenum error = ilGetError();
-        ilDeleteImages(1, &imageID);
+    // La imagen se lee y se sube en segundo plano solo la primera vez; las siguientes cargas comparten la misma textura
+    std::shared_ptr<Texture> loaded = TextureManager::GetInstance().Load(path);
+    if (!loaded) {
         return false;
     }
 
-    textureWidth = ilGetInteger(IL_IMAGE_WIDTH);
-    textureHeight = ilGetInteger(IL_IMAGE_HEIGHT);
-    ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE);
-
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, ilGetData());
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    ilDeleteImages(1, &imageID);
-
-    int glWidth, glHeight;
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &glWidth);
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &glHeight);
-
+    texture = loaded;
     texturePath = path;
-    hasTexture = (textureID != 0);
-    Logger::GetInstance().Log(hasTexture ? "TEXTURE WAS SUCCESSFULLY ADDED" : "OBJECT INVALID TO ADD", hasTexture ? INFO : WARNING);
 
-    return hasTexture;
+    return true;
+}
+
+unsigned int Material::getTextureID() const {
+    if (!texture || texture->hasFailed()) {
+        return 0;
+    }
+    if (!texture->isReady()) {
+        return TextureManager::GetInstance().GetCheckerTexture()->getID();
+    }
+    return texture->getID();
 }
 
 GLuint Material::generateCheckeredTexture(int width, int height) {
@@ -86,15 +60,11 @@ GLuint Material::generateCheckeredTexture(int width, int height) {
     return textureID;
 }
 
-void Material::use() const {
-    if (hasTexture) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-    }
-    else {
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(defaultColor.r, defaultColor.g, defaultColor.b);
-    }
+void Material::use(RenderStateCache& state) const {
+    GLuint textureID = getTextureID();
+    state.setTexture(textureID);
+    // Con textura se modula por blanco, como antes
+    state.setColor(textureID ? glm::vec3(1.0f) : defaultColor);
 }
 
 void Material::setDefaultColor(const glm::vec3& color) {
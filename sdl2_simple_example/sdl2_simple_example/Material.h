@@ -4,37 +4,43 @@
 //#include <GL/glew.h> // Incluye GLEW para definir GLuint
 #include <glm/glm.hpp>
 #include <string>
+#include <memory>
+#include "TextureManager.h"
+
+class RenderStateCache;
 
 class Material {
 public:
     Material();
     ~Material();
     bool loadTexture(const std::string& path);
-    void use() const;
+    // Aplica la textura (o el color por defecto) a travs de la cach de estado del Renderer
+    void use(RenderStateCache& state) const;
     void setDefaultColor(const glm::vec3& color);
+    const glm::vec3& getDefaultColor() const { return defaultColor; }
 
     // Nuevos mtodos para obtener la textura y sus dimensiones
-    unsigned int getTextureID() const { return textureID; }
-    bool hasLoadedTexture() const { return hasTexture; }
+    // Mientras la textura llega en segundo plano devuelve la de cuadros; 0 si no hay textura o fall
+    unsigned int getTextureID() const;
+    bool hasLoadedTexture() const { return texture != nullptr; }
 
-    int getTextureWidth() const { return textureWidth; }
-    int getTextureHeight() const { return textureHeight; }
+    int getTextureWidth() const { return texture ? texture->getWidth() : 0; }
+    int getTextureHeight() const { return texture ? texture->getHeight() : 0; }
 
 
     const std::string& getTexturePath() const { return texturePath; }
-    void setTexture(unsigned int texture) { textureID = texture; }
+
+    // Cambia la textura que se dibuja sin olvidar la ruta cargada (se usa para mostrar la de cuadros)
+    void setTexture(std::shared_ptr<Texture> newTexture) { texture = std::move(newTexture); }
 
     // Mtodo para cargar la textura de cuadros
     static unsigned int generateCheckeredTexture(int width, int height);
 
 private:
 
-    unsigned int textureID;
-    bool hasTexture;
+    std::shared_ptr<Texture> texture; // Compartida con el resto de materiales que usan la misma imagen
     glm::vec3 defaultColor;
     std::string texturePath;
-
-    int textureWidth, textureHeight;
 };
 
 #endif // MATERIAL_H
\ No newline at end of file
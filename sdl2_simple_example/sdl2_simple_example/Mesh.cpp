@@ -0,0 +1,103 @@
+#include <GL/glew.h>
+#include "Mesh.h"
+#include <utility>
+
+Mesh::Mesh() : vao(0), vbo(0), ibo(0), indexCount(0) {}
+
+Mesh::~Mesh() {
+    release();
+}
+
+Mesh::Mesh(Mesh&& other) noexcept
+    : vao(other.vao), vbo(other.vbo), ibo(other.ibo), indexCount(other.indexCount) {
+    other.vao = other.vbo = other.ibo = 0;
+    other.indexCount = 0;
+}
+
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(vao, other.vao);
+        std::swap(vbo, other.vbo);
+        std::swap(ibo, other.ibo);
+        std::swap(indexCount, other.indexCount);
+    }
+    return *this;
+}
+
+void Mesh::upload(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t count) {
+    release();
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ibo);
+
+    // El VAO guarda los punteros de los arrays de vértices, así que solo se configuran una vez
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertices, GL_STATIC_DRAW);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, x)));
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_FLOAT, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, nx)));
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, u)));
+
+    glEnableVertexAttribArray(POSITION_LOCATION);
+    glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, x)));
+    glEnableVertexAttribArray(NORMAL_LOCATION);
+    glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, nx)));
+    glEnableVertexAttribArray(TEXCOORD_LOCATION);
+    glVertexAttribPointer(TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, u)));
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    indexCount = static_cast<unsigned int>(count);
+}
+
+void Mesh::draw() const {
+    if (!vao) return;
+
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+}
+
+void Mesh::drawInstanced(unsigned int instanceBuffer, size_t offset, unsigned int instanceCount, unsigned int matrixLocation) const {
+    if (!vao || instanceCount == 0) return;
+
+    // Los punteros de instancia cambian en cada lote (todos comparten el mismo buffer), así que se
+    // activan solo durante la llamada y el VAO queda como estaba para el camino sin shaders
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (unsigned int column = 0; column < 4; column++) {
+        glEnableVertexAttribArray(matrixLocation + column);
+        glVertexAttribPointer(matrixLocation + column, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
+                              reinterpret_cast<void*>(offset + column * sizeof(float) * 4));
+        glVertexAttribDivisorARB(matrixLocation + column, 1);
+    }
+
+    glDrawElementsInstancedARB(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+
+    for (unsigned int column = 0; column < 4; column++) {
+        glVertexAttribDivisorARB(matrixLocation + column, 0);
+        glDisableVertexAttribArray(matrixLocation + column);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::release() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (ibo) glDeleteBuffers(1, &ibo);
+    vao = vbo = ibo = 0;
+    indexCount = 0;
+}
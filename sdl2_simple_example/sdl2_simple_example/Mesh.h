@@ -0,0 +1,63 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+struct Vertex {
+    float x, y, z;    // Posición
+    float nx, ny, nz; // Normales
+    float u, v;       // Coordenadas UV
+};
+
+// Datos de una malla en CPU: vértices, índices ya triangulados y la topología original de las caras
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;     // Triángulos (3 índices por cara)
+    std::vector<unsigned int> faceSizes;   // Número de vértices de cada cara original
+    std::vector<unsigned int> faceIndices; // Índices de las caras originales, concatenados
+    AABB aabb;                             // Volúmenes envolventes en espacio local, calculados al importar
+    BoundingSphere sphere;
+};
+
+// Malla residente en la GPU: un VAO con un VBO de vértices intercalados y un IBO de índices. El VAO tiene a la vez los
+// arrays del pipeline fijo y los atributos genéricos, así que sirve para los dos caminos de dibujo.
+// Se sube una sola vez al cargar el modelo y se dibuja con una única llamada indexada.
+class Mesh {
+public:
+    // Atributos genéricos para los shaders del perfil core. Coinciden con los que algunos drivers comparten con
+    // gl_Vertex, gl_Normal y gl_MultiTexCoord0, que apuntan a los mismos datos, así que no se pisan.
+    static constexpr unsigned int POSITION_LOCATION = 0;
+    static constexpr unsigned int NORMAL_LOCATION = 2;
+    static constexpr unsigned int TEXCOORD_LOCATION = 8;
+
+    Mesh();
+    ~Mesh();
+
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    // Crea los buffers y copia los datos a la GPU
+    void upload(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount);
+    void draw() const;
+
+    // Dibuja instanceCount copias con una sola llamada. La matriz de modelo de cada instancia se lee del
+    // buffer de instancias (mat4 por instancia a partir de offset) en los atributos matrixLocation..+3.
+    void drawInstanced(unsigned int instanceBuffer, size_t offset, unsigned int instanceCount, unsigned int matrixLocation) const;
+    void release();
+
+    bool isUploaded() const { return vao != 0; }
+    unsigned int getIndexCount() const { return indexCount; }
+
+private:
+    unsigned int vao;
+    unsigned int vbo;
+    unsigned int ibo;
+    unsigned int indexCount;
+};
+
+#endif // MESH_H
@@ -0,0 +1,177 @@
+#include "MeshCache.h"
+#include "MeshCooker.h"
+#include "AssetPath.h"
+#include "Logger.h"
+
+MeshResource::MeshResource(const std::string& path, std::vector<MeshData>&& data)
+    : path(path), meshData(std::move(data)), uploadedMeshes(0) {
+    meshes.resize(meshData.size());
+    computeBounds();
+}
+
+MeshResource::MeshResource(const std::string& path, std::unique_ptr<CookedMeshFile> file)
+    : path(path), cookedFile(std::move(file)), uploadedMeshes(0) {
+    meshData.resize(cookedFile->getMeshCount());
+    meshes.resize(cookedFile->getMeshCount());
+    for (size_t i = 0; i < meshData.size(); i++) {
+        cookedFile->readBounds(i, meshData[i]);
+    }
+    computeBounds();
+}
+
+MeshResource::~MeshResource() {}
+
+const std::vector<MeshData>& MeshResource::getMeshData() const {
+    loadMeshData();
+    return meshData;
+}
+
+// Copia los bloques del fichero cocinado la primera vez que se necesitan en CPU; a partir de ahí el fichero
+// sobra (si aún quedaban mallas por subir, se suben desde la copia). Con índices fuera de rango no se deja
+// nada en CPU, así que los BVH y las normales de este recurso quedan vacíos en lugar de leer fuera de los vértices.
+void MeshResource::loadMeshData() const {
+    if (!cookedFile) return;
+
+    for (size_t i = 0; i < meshData.size(); i++) {
+        if (!cookedFile->readMesh(i, meshData[i])) {
+            for (MeshData& data : meshData) {
+                data.vertices.clear();
+                data.indices.clear();
+                data.faceSizes.clear();
+                data.faceIndices.clear();
+            }
+            discardCookedFile();
+            break;
+        }
+    }
+    cookedFile.reset();
+}
+
+void MeshResource::discardCookedFile() const {
+    if (damaged) return;
+
+    damaged = true;
+    Logger::GetInstance().Log("COOKED MESH IS DAMAGED, IT WILL BE RECOOKED: " + path, WARNING);
+    MeshCooker::discard(MeshCooker::getCookedPath(path));
+    MeshCache::GetInstance().Remove(path, this);
+}
+
+// Volúmenes de todo el asset a partir de los de cada malla, una sola vez
+void MeshResource::computeBounds() {
+    aabb = AABB();
+    for (const MeshData& data : meshData) {
+        if (data.aabb.isValid()) aabb.add(data.aabb);
+    }
+
+    sphere = BoundingSphere();
+    if (!aabb.isValid()) return;
+    sphere.center = aabb.getCenter();
+    for (const MeshData& data : meshData) {
+        if (data.aabb.isValid()) sphere.add(data.sphere);
+    }
+}
+
+bool MeshResource::raycast(const Ray& ray, float maxDistance, float& hitDistance) const {
+    if (triangleBVHs.size() != meshData.size()) {
+        loadMeshData();
+        triangleBVHs.resize(meshData.size());
+        for (size_t i = 0; i < meshData.size(); i++) {
+            triangleBVHs[i].build(meshData[i]);
+        }
+    }
+
+    glm::vec3 inverseDirection = 1.0f / ray.direction;
+    bool hit = false;
+    for (size_t i = 0; i < meshData.size(); i++) {
+        if (!meshData[i].aabb.isValid()) continue;
+        if (RayBoxEnter(meshData[i].aabb, ray.origin, inverseDirection, maxDistance) < 0.0f) continue;
+        if (triangleBVHs[i].raycast(meshData[i], ray, maxDistance, maxDistance)) hit = true;
+    }
+    if (hit) hitDistance = maxDistance;
+    return hit;
+}
+
+const std::vector<NormalLines>& MeshResource::getNormalLines() const {
+    if (normalLines.size() != meshData.size()) {
+        loadMeshData();
+        normalLines.resize(meshData.size());
+        for (size_t i = 0; i < meshData.size(); i++) {
+            normalLines[i].build(meshData[i]);
+        }
+    }
+    return normalLines;
+}
+
+bool MeshResource::uploadNext() {
+    if (uploadedMeshes >= meshData.size()) return false;
+
+    if (cookedFile) {
+        // Una malla con índices fuera de rango no se sube (Mesh no dibuja lo que no tiene VAO)
+        const CookedMeshView& view = cookedFile->getMesh(uploadedMeshes);
+        if (cookedFile->hasValidTriangles(uploadedMeshes)) {
+            meshes[uploadedMeshes].upload(view.vertices, view.info->vertexCount, view.indices, view.info->indexCount);
+        }
+        else {
+            discardCookedFile();
+        }
+    }
+    else {
+        const MeshData& data = meshData[uploadedMeshes];
+        meshes[uploadedMeshes].upload(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size());
+    }
+    uploadedMeshes++;
+    return uploadedMeshes < meshData.size();
+}
+
+void MeshResource::uploadAll() {
+    while (uploadNext()) {}
+}
+
+std::string MeshCache::GetKey(const std::string& path) {
+    return GetAssetKey(path);
+}
+
+std::shared_ptr<const MeshResource> MeshCache::Find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = resources.find(key);
+    if (it == resources.end()) return nullptr;
+    return it->second.lock();
+}
+
+std::shared_ptr<const MeshResource> MeshCache::Add(const std::string& key, std::shared_ptr<const MeshResource> resource) {
+    if (resource->isDamaged()) return resource;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    PruneExpired();
+
+    std::weak_ptr<const MeshResource>& entry = resources[key];
+    if (std::shared_ptr<const MeshResource> existing = entry.lock()) {
+        return existing;
+    }
+    entry = resource;
+    return resource;
+}
+
+void MeshCache::Remove(const std::string& key, const MeshResource* resource) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = resources.find(key);
+    if (it == resources.end()) return;
+
+    std::shared_ptr<const MeshResource> current = it->second.lock();
+    if (!current || current.get() == resource) {
+        resources.erase(it);
+    }
+}
+
+size_t MeshCache::GetResourceCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    PruneExpired();
+    return resources.size();
+}
+
+void MeshCache::PruneExpired() {
+    for (auto it = resources.begin(); it != resources.end();) {
+        if (it->second.expired()) it = resources.erase(it);
+        else ++it;
+    }
+}
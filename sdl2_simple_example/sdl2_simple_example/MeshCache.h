@@ -0,0 +1,106 @@
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Mesh.h"
+#include "TriangleBVH.h"
+#include "NormalLines.h"
+
+class CookedMeshFile;
+
+// Geometría de un asset compartida por todos los GameObjects que lo usan: datos en CPU y mallas en GPU.
+// Mientras se sube es propiedad exclusiva del cargador; una vez en la caché ya no se modifica.
+class MeshResource {
+public:
+    MeshResource(const std::string& path, std::vector<MeshData>&& data);
+
+    // Sube directamente desde un fichero cocinado mapeado en memoria, que el recurso mantiene abierto. Al principio
+    // solo se leen los volúmenes; el resto de datos en CPU se copian la primera vez que alguien los pide.
+    MeshResource(const std::string& path, std::unique_ptr<CookedMeshFile> file);
+    ~MeshResource();
+
+    MeshResource(const MeshResource&) = delete;
+    MeshResource& operator=(const MeshResource&) = delete;
+
+    // Sube la siguiente malla a la GPU; devuelve false cuando ya no quedan
+    bool uploadNext();
+    void uploadAll();
+
+    bool isUploaded() const { return uploadedMeshes == meshes.size(); }
+
+    // El fichero cocinado del que sale tenía índices fuera de rango: ya se ha borrado y el recurso no se comparte
+    bool isDamaged() const { return damaged; }
+    size_t getUploadedMeshCount() const { return uploadedMeshes; }
+
+    const std::string& getPath() const { return path; }
+    size_t getMeshCount() const { return meshes.size(); }
+    const std::vector<MeshData>& getMeshData() const;
+    const std::vector<Mesh>& getMeshes() const { return meshes; }
+
+    // Envolventes de todas las mallas juntas, en el espacio del asset
+    const AABB& getAABB() const { return aabb; }
+    const BoundingSphere& getSphere() const { return sphere; }
+
+    // Impacto más cercano del rayo (en el espacio del asset) con los triángulos de cualquiera de las mallas.
+    // Los BVH de triángulos se construyen la primera vez que se lanza un rayo contra el recurso.
+    bool raycast(const Ray& ray, float maxDistance, float& hitDistance) const;
+
+    // Líneas de normales de cada malla; se calculan y se suben la primera vez que alguien las muestra
+    const std::vector<NormalLines>& getNormalLines() const;
+
+private:
+    std::string path;
+    mutable std::vector<MeshData> meshData;                 // Con fichero cocinado, solo los volúmenes hasta que se piden
+    mutable std::unique_ptr<CookedMeshFile> cookedFile;     // Se cierra al copiar sus datos a meshData
+    std::vector<Mesh> meshes;
+    size_t uploadedMeshes;
+    AABB aabb;
+    BoundingSphere sphere;
+    mutable std::vector<TriangleBVH> triangleBVHs;  // Uno por malla; solo se usan desde el hilo principal
+    mutable std::vector<NormalLines> normalLines;   // Igual, y además necesitan el contexto de OpenGL
+    mutable bool damaged = false;
+
+    void computeBounds();
+    void loadMeshData() const;
+    void discardCookedFile() const;
+};
+
+// Caché de mallas por ruta de asset. Guarda referencias débiles: un recurso se libera (CPU y GPU)
+// en cuanto el último GameObject que lo usa desaparece.
+class MeshCache {
+public:
+    static MeshCache& GetInstance() {
+        static MeshCache instance;
+        return instance;
+    }
+
+    // Clave normalizada de una ruta (ver GetAssetKey)
+    static std::string GetKey(const std::string& path);
+
+    std::shared_ptr<const MeshResource> Find(const std::string& key);
+
+    // Registra un recurso ya subido; si otro se registró antes con la misma clave, devuelve ese.
+    // Un recurso dañado no se registra, para que la próxima carga vuelva a cocinar el asset.
+    std::shared_ptr<const MeshResource> Add(const std::string& key, std::shared_ptr<const MeshResource> resource);
+
+    // Quita la entrada de la clave si todavía apunta a ese recurso
+    void Remove(const std::string& key, const MeshResource* resource);
+
+    size_t GetResourceCount();
+
+private:
+    MeshCache() = default;
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+
+    void PruneExpired();
+
+    std::unordered_map<std::string, std::weak_ptr<const MeshResource>> resources;
+    std::mutex mutex;
+};
+
+#endif // MESHCACHE_H
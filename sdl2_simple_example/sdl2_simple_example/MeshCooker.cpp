@@ -0,0 +1,174 @@
+#include "MeshCooker.h"
+#include "AssetPath.h"
+#include "Profiler.h"
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <cstring>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static const char COOKED_MESH_MAGIC[4] = { 'T', '4', '1', 'M' };
+static const uint32_t COOKED_MESH_VERSION = 3;
+static const char* COOKED_MESH_DIRECTORY = "Library/Meshes";
+
+bool CookedMeshFile::open(const std::string& path) {
+    views.clear();
+    if (!file.open(path)) return false;
+
+    const unsigned char* data = file.getData();
+    size_t size = file.getSize();
+
+    if (size < sizeof(CookedMeshHeader)) return false;
+    const CookedMeshHeader* header = reinterpret_cast<const CookedMeshHeader*>(data);
+    if (std::memcmp(header->magic, COOKED_MESH_MAGIC, sizeof(COOKED_MESH_MAGIC)) != 0 || header->version != COOKED_MESH_VERSION) {
+        return false;
+    }
+
+    size_t offset = sizeof(CookedMeshHeader);
+    if (header->meshCount > (size - offset) / sizeof(CookedMeshInfo)) return false;
+    const CookedMeshInfo* infos = reinterpret_cast<const CookedMeshInfo*>(data + offset);
+    offset += header->meshCount * sizeof(CookedMeshInfo);
+
+    // Cada bloque se comprueba contra el tamaño del fichero antes de crear la vista
+    auto take = [&](size_t bytes) -> const unsigned char* {
+        if (bytes > size - offset) return nullptr;
+        const unsigned char* block = data + offset;
+        offset += bytes;
+        return block;
+    };
+
+    views.resize(header->meshCount);
+    for (uint32_t i = 0; i < header->meshCount; i++) {
+        const CookedMeshInfo& info = infos[i];
+        CookedMeshView& view = views[i];
+        view.info = &info;
+        view.vertices = reinterpret_cast<const Vertex*>(take(size_t(info.vertexCount) * sizeof(Vertex)));
+        view.indices = reinterpret_cast<const unsigned int*>(take(size_t(info.indexCount) * sizeof(unsigned int)));
+        view.faceSizes = reinterpret_cast<const unsigned int*>(take(size_t(info.faceCount) * sizeof(unsigned int)));
+        view.faceIndices = reinterpret_cast<const unsigned int*>(take(size_t(info.faceIndexCount) * sizeof(unsigned int)));
+
+        if (!view.vertices || !view.indices || !view.faceSizes || !view.faceIndices || info.indexCount % 3 != 0) {
+            views.clear();
+            return false;
+        }
+
+        // Las caras deben repartirse exactamente los índices de cara (se suma en 64 bits por si un tamaño está dañado).
+        // Los índices en sí no se miran aquí: se comprueban al subirlos o al copiarlos.
+        uint64_t faceIndexTotal = 0;
+        for (uint32_t f = 0; f < info.faceCount; f++) {
+            faceIndexTotal += view.faceSizes[f];
+        }
+        if (faceIndexTotal != info.faceIndexCount) {
+            views.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool IndicesInRange(const unsigned int* indices, size_t count, uint32_t vertexCount) {
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] >= vertexCount) return false;
+    }
+    return true;
+}
+
+bool CookedMeshFile::hasValidTriangles(size_t index) const {
+    const CookedMeshView& view = views[index];
+    return IndicesInRange(view.indices, view.info->indexCount, view.info->vertexCount);
+}
+
+bool CookedMeshFile::readMesh(size_t index, MeshData& out) const {
+    const CookedMeshView& view = views[index];
+    const CookedMeshInfo& info = *view.info;
+
+    if (!IndicesInRange(view.indices, info.indexCount, info.vertexCount) ||
+        !IndicesInRange(view.faceIndices, info.faceIndexCount, info.vertexCount)) {
+        return false;
+    }
+
+    out.vertices.assign(view.vertices, view.vertices + info.vertexCount);
+    out.indices.assign(view.indices, view.indices + info.indexCount);
+    out.faceSizes.assign(view.faceSizes, view.faceSizes + info.faceCount);
+    out.faceIndices.assign(view.faceIndices, view.faceIndices + info.faceIndexCount);
+    readBounds(index, out);
+    return true;
+}
+
+void CookedMeshFile::readBounds(size_t index, MeshData& out) const {
+    const CookedMeshInfo& info = *views[index].info;
+    out.aabb.min = glm::vec3(info.aabbMin[0], info.aabbMin[1], info.aabbMin[2]);
+    out.aabb.max = glm::vec3(info.aabbMax[0], info.aabbMax[1], info.aabbMax[2]);
+    out.sphere.center = glm::vec3(info.sphereCenter[0], info.sphereCenter[1], info.sphereCenter[2]);
+    out.sphere.radius = info.sphereRadius;
+}
+
+std::string MeshCooker::getCookedPath(const std::string& assetPath) {
+    return GetCookedAssetPath(assetPath, COOKED_MESH_DIRECTORY, ".t41mesh");
+}
+
+bool MeshCooker::isUpToDate(const std::string& assetPath, const std::string& cookedPath) {
+    return IsCookedAssetUpToDate(assetPath, cookedPath);
+}
+
+void MeshCooker::discard(const std::string& cookedPath) {
+    std::error_code error;
+    fs::remove(cookedPath, error);
+}
+
+bool MeshCooker::save(const std::string& cookedPath, const std::vector<MeshData>& meshes) {
+    PROFILE_SCOPE("Cook Mesh");
+    std::error_code error;
+    fs::create_directories(fs::path(cookedPath).parent_path(), error);
+
+    // Se escribe en un temporal propio de cada hilo y se renombra para no dejar nunca un fichero a medias
+    std::string tempPath = cookedPath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        CookedMeshHeader header = {};
+        std::memcpy(header.magic, COOKED_MESH_MAGIC, sizeof(COOKED_MESH_MAGIC));
+        header.version = COOKED_MESH_VERSION;
+        header.meshCount = static_cast<uint32_t>(meshes.size());
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const MeshData& mesh : meshes) {
+            CookedMeshInfo info = {};
+            info.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+            info.indexCount = static_cast<uint32_t>(mesh.indices.size());
+            info.faceCount = static_cast<uint32_t>(mesh.faceSizes.size());
+            info.faceIndexCount = static_cast<uint32_t>(mesh.faceIndices.size());
+            for (int k = 0; k < 3; k++) {
+                info.aabbMin[k] = mesh.aabb.min[k];
+                info.aabbMax[k] = mesh.aabb.max[k];
+                info.sphereCenter[k] = mesh.sphere.center[k];
+            }
+            info.sphereRadius = mesh.sphere.radius;
+            out.write(reinterpret_cast<const char*>(&info), sizeof(info));
+        }
+
+        for (const MeshData& mesh : meshes) {
+            out.write(reinterpret_cast<const char*>(mesh.vertices.data()), mesh.vertices.size() * sizeof(Vertex));
+            out.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(unsigned int));
+            out.write(reinterpret_cast<const char*>(mesh.faceSizes.data()), mesh.faceSizes.size() * sizeof(unsigned int));
+            out.write(reinterpret_cast<const char*>(mesh.faceIndices.data()), mesh.faceIndices.size() * sizeof(unsigned int));
+        }
+
+        if (!out) {
+            out.close();
+            fs::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, cookedPath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
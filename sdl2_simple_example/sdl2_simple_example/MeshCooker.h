@@ -0,0 +1,80 @@
+#ifndef MESHCOOKER_H
+#define MESHCOOKER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Mesh.h"
+#include "MappedFile.h"
+
+// Formato binario de mallas cocinadas (.t41mesh):
+//   CookedMeshHeader
+//   CookedMeshInfo x meshCount
+//   por cada malla: vértices, índices, tamaños de cara e índices de cara, seguidos y sin relleno
+// Todos los bloques son múltiplos de 4 bytes, así que pueden leerse directamente desde el mapeo.
+struct CookedMeshHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t meshCount;
+    uint32_t reserved;
+};
+
+struct CookedMeshInfo {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t faceCount;
+    uint32_t faceIndexCount;
+    float aabbMin[3];
+    float aabbMax[3];
+    float sphereCenter[3];
+    float sphereRadius;
+};
+
+// Vista de una malla dentro del fichero mapeado; los punteros son válidos mientras el fichero siga abierto
+struct CookedMeshView {
+    const CookedMeshInfo* info;
+    const Vertex* vertices;
+    const unsigned int* indices;
+    const unsigned int* faceSizes;
+    const unsigned int* faceIndices;
+};
+
+class CookedMeshFile {
+public:
+    // Mapea el fichero y valida la cabecera y los tamaños de cada bloque
+    bool open(const std::string& path);
+
+    size_t getMeshCount() const { return views.size(); }
+    const CookedMeshView& getMesh(size_t index) const { return views[index]; }
+
+    // Solo los volúmenes envolventes de una malla, sin tocar sus bloques
+    void readBounds(size_t index, MeshData& out) const;
+
+    // Los índices de triángulos de una malla apuntan a vértices existentes. Solo recorre ese bloque, sin copiar
+    // nada, y se comprueba antes de dárselo a glDrawElements.
+    bool hasValidTriangles(size_t index) const;
+
+    // Copia una malla completa a memoria propia; solo hace falta para el trabajo en CPU (normales y picking).
+    // Devuelve false si algún índice de triángulo o de cara se sale de los vértices.
+    bool readMesh(size_t index, MeshData& out) const;
+
+private:
+    MappedFile file;
+    std::vector<CookedMeshView> views;
+};
+
+class MeshCooker {
+public:
+    // Ruta del fichero cocinado correspondiente a un asset (Library/Meshes/<nombre>_<hash>.t41mesh)
+    static std::string getCookedPath(const std::string& assetPath);
+
+    // El fichero cocinado existe y es más reciente que el asset original
+    static bool isUpToDate(const std::string& assetPath, const std::string& cookedPath);
+
+    static bool save(const std::string& cookedPath, const std::vector<MeshData>& meshes);
+
+    // Borra un fichero cocinado dañado para que la próxima carga vuelva a importar y cocinar el asset
+    static void discard(const std::string& cookedPath);
+};
+
+#endif // MESHCOOKER_H
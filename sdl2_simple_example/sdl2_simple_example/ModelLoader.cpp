@@ -1,194 +1,248 @@
 #include <GL/glew.h>
 #include "ModelLoader.h"
+#include "MeshCooker.h"
+#include "MeshCache.h"
+#include "AssetLoader.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
 #include <iostream>
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
 
-ModelLoader::ModelLoader() : scene(nullptr) {}
+ModelLoader::ModelLoader() {}
 
-ModelLoader::~ModelLoader() {
-    scene = nullptr;
-}
+ModelLoader::~ModelLoader() {}
 
 bool ModelLoader::loadModel(const std::string& path) {
-    const aiScene* originalScene = importer.ReadFile(path, aiProcess_FlipUVs | aiProcess_GenUVCoords);
-    if (!originalScene || originalScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !originalScene->mRootNode) {
-        Logger::GetInstance().Log("OBJECT INVALID TO ADD", WARNING);
-        return false;
+    PROFILE_SCOPE("Load Model");
+    // Si el asset ya está cargado por otro GameObject se comparte, sin leer nada del disco
+    std::string key = MeshCache::GetKey(path);
+    if (std::shared_ptr<const MeshResource> cached = MeshCache::GetInstance().Find(key)) {
+        setMesh(cached);
+        Logger::GetInstance().Log("OBJECT WAS SUCCESFULLY ADDED", INFO);
+        return true;
     }
 
-    originalQuads.clear();
-    for (unsigned int i = 0; i < originalScene->mNumMeshes; i++) {
-        aiMesh* mesh = originalScene->mMeshes[i];
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            aiFace& face = mesh->mFaces[j];
-            if (face.mNumIndices == 4) {
-                originalQuads.push_back({ face.mIndices[0], face.mIndices[1], face.mIndices[2], face.mIndices[3] });
-            }
-        }
+    // Si el AssetLoader ya lo está cargando en segundo plano, se termina ese trabajo en vez de importarlo otra vez
+    if (std::shared_ptr<const MeshResource> loaded = AssetLoader::GetInstance().FinishModelNow(key)) {
+        setMesh(loaded);
+        Logger::GetInstance().Log("OBJECT WAS SUCCESFULLY ADDED", INFO);
+        return true;
     }
 
-    scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenUVCoords);
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+    // Si ya existe una versión cocinada y actualizada del asset, Assimp no interviene y se sube desde el mapeo
+    std::vector<MeshData> data;
+    std::unique_ptr<CookedMeshFile> cooked;
+    if (!readMeshes(path, data, cooked)) {
         Logger::GetInstance().Log("OBJECT INVALID TO ADD", WARNING);
         return false;
     }
 
+    std::shared_ptr<MeshResource> resource = cooked ? std::make_shared<MeshResource>(key, std::move(cooked))
+                                                    : std::make_shared<MeshResource>(key, std::move(data));
+    resource->uploadAll();
+
+    setMesh(MeshCache::GetInstance().Add(key, resource));
+
     Logger::GetInstance().Log("OBJECT WAS SUCCESFULLY ADDED", INFO);
-    primitiveVertices.clear();
     return true;
 }
 
-void ModelLoader::drawModel() {
-    if (scene) {
-        drawNode(scene->mRootNode, scene);
+void ModelLoader::setMesh(std::shared_ptr<const MeshResource> mesh) {
+    resource = std::move(mesh);
+    primitiveVertices.clear();
+}
 
-        if (showTriangleNormals) {
-            drawTriangleNormals();
-        }
-        if (showFaceNormals) {
-            drawFaceNormals();
-        }
-    }
-    else if (!primitiveVertices.empty()) {
-        drawPrimitive();
-    }
+size_t ModelLoader::getMeshCount() const {
+    return resource ? resource->getMeshCount() : 0;
 }
 
-void ModelLoader::drawNode(aiNode* node, const aiScene* scene) {
-    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+const std::vector<MeshData>& ModelLoader::getMeshData() const {
+    static const std::vector<MeshData> empty;
+    return resource ? resource->getMeshData() : empty;
+}
 
-        glPushMatrix();
-        float scale = 0.2f;
-        glScalef(scale, scale, scale);
+AABB ModelLoader::getLocalAABB() const {
+    if (!resource || !resource->getAABB().isValid()) return AABB();
 
-        glBegin(GL_TRIANGLES);
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            aiFace& face = mesh->mFaces[j];
-            for (unsigned int k = 0; k < face.mNumIndices; k++) {
-                unsigned int index = face.mIndices[k];
-                if (mesh->HasNormals()) {
-                    glNormal3fv(&mesh->mNormals[index].x);
-                }
-                if (mesh->HasTextureCoords(0)) {
-                    glTexCoord2f(mesh->mTextureCoords[0][index].x, -mesh->mTextureCoords[0][index].y);
-                }
-                glVertex3fv(&mesh->mVertices[index].x);
-            }
-        }
-        glEnd();
+    AABB local;
+    local.min = resource->getAABB().min * MODEL_SCALE;
+    local.max = resource->getAABB().max * MODEL_SCALE;
+    return local;
+}
+
+BoundingSphere ModelLoader::getLocalSphere() const {
+    if (!resource) return BoundingSphere();
+
+    BoundingSphere local;
+    local.center = resource->getSphere().center * MODEL_SCALE;
+    local.radius = resource->getSphere().radius * MODEL_SCALE;
+    return local;
+}
 
-        glPopMatrix();
+bool ModelLoader::readMeshes(const std::string& path, std::vector<MeshData>& out, std::unique_ptr<CookedMeshFile>& cooked) {
+    PROFILE_SCOPE("Read Meshes");
+    std::string cookedPath = MeshCooker::getCookedPath(path);
+    if (MeshCooker::isUpToDate(path, cookedPath)) {
+        cooked = std::make_unique<CookedMeshFile>();
+        if (cooked->open(cookedPath)) return true;
+        cooked.reset();
     }
 
-    for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        drawNode(node->mChildren[i], scene);
+    if (!importModel(path, out)) {
+        return false;
     }
-}
 
-void ModelLoader::drawPrimitive() {
-    glBegin(GL_TRIANGLES);
-    for (const auto& vertex : primitiveVertices) {
-        glNormal3f(vertex.nx, vertex.ny, vertex.nz);
-        glTexCoord2f(vertex.u, vertex.v);
-        glVertex3f(vertex.x, vertex.y, vertex.z);
+    // Si no se puede cocinar, el modelo sigue siendo válido; solo se volverá a importar la próxima vez
+    if (!MeshCooker::save(cookedPath, out)) {
+        Logger::GetInstance().Log("COULD NOT WRITE COOKED MESH", WARNING);
     }
-    glEnd();
+    return true;
 }
 
-const aiScene* ModelLoader::getScene() const {
-    return scene;
-}
+// Mallas en el orden en que las recorre el árbol de nodos. Los nodos se dibujaban sin su transformación, así que una
+// malla que aparece en varios nodos se guarda una sola vez (sus copias quedaban superpuestas) y las que no cuelgan
+// de ningún nodo, que nunca se dibujaban, se descartan.
+static void CollectNodeMeshes(const aiNode* node, std::vector<bool>& used, std::vector<unsigned int>& order) {
+    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
+        unsigned int meshIndex = node->mMeshes[i];
+        if (meshIndex < used.size() && !used[meshIndex]) {
+            used[meshIndex] = true;
+            order.push_back(meshIndex);
+        }
+    }
 
-void ModelLoader::setShowTriangleNormals(bool show) {
-    showTriangleNormals = show;
+    for (unsigned int i = 0; i < node->mNumChildren; i++) {
+        CollectNodeMeshes(node->mChildren[i], used, order);
+    }
 }
 
-void ModelLoader::setShowFaceNormals(bool show) {
-    showFaceNormals = show;
-}
+// Paso de importación: convierte cada aiMesh en vértices intercalados, índices triangulados y caras originales
+bool ModelLoader::importModel(const std::string& path, std::vector<MeshData>& meshData) {
+    // Una sola lectura sin aiProcess_Triangulate: la topología original se conserva y los
+    // triángulos se generan a partir de las mismas caras
+    Assimp::Importer importer;
+    const aiScene* scene = nullptr;
+    {
+        PROFILE_SCOPE("Assimp ReadFile");
+        scene = importer.ReadFile(path, aiProcess_FlipUVs | aiProcess_GenUVCoords);
+    }
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        return false;
+    }
 
-// Dibuja las normales de las caras del modelo triangulado
-void ModelLoader::drawTriangleNormals() {
-    if (!scene) return;
+    PROFILE_SCOPE("Convert Meshes");
+    std::vector<bool> used(scene->mNumMeshes, false);
+    std::vector<unsigned int> order;
+    CollectNodeMeshes(scene->mRootNode, used, order);
+
+    meshData.clear();
+    meshData.resize(order.size());
+
+    for (size_t i = 0; i < order.size(); i++) {
+        aiMesh* mesh = scene->mMeshes[order[i]];
+        MeshData& data = meshData[i];
+        std::vector<Vertex>& vertices = data.vertices;
+
+        data.aabb = AABB();
+        vertices.resize(mesh->mNumVertices);
+        for (unsigned int v = 0; v < mesh->mNumVertices; v++) {
+            Vertex& vertex = vertices[v];
+            vertex.x = mesh->mVertices[v].x;
+            vertex.y = mesh->mVertices[v].y;
+            vertex.z = mesh->mVertices[v].z;
+            data.aabb.add(glm::vec3(vertex.x, vertex.y, vertex.z));
+            if (mesh->HasNormals()) {
+                vertex.nx = mesh->mNormals[v].x;
+                vertex.ny = mesh->mNormals[v].y;
+                vertex.nz = mesh->mNormals[v].z;
+            }
+            else {
+                vertex.nx = vertex.ny = vertex.nz = 0.0f;
+            }
+            if (mesh->HasTextureCoords(0)) {
+                vertex.u = mesh->mTextureCoords[0][v].x;
+                vertex.v = -mesh->mTextureCoords[0][v].y;
+            }
+            else {
+                vertex.u = vertex.v = 0.0f;
+            }
+        }
+        // La esfera se centra en la caja y se ajusta al vértice más alejado (más ceñida que la semidiagonal)
+        // Una malla sin vértices conserva la caja inválida y no cuenta al combinar volúmenes
+        data.sphere = BoundingSphere();
+        if (!vertices.empty()) {
+            data.sphere.center = data.aabb.getCenter();
+            float radiusSquared = 0.0f;
+            for (const Vertex& vertex : vertices) {
+                glm::vec3 offset = glm::vec3(vertex.x, vertex.y, vertex.z) - data.sphere.center;
+                radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+            }
+            data.sphere.radius = std::sqrt(radiusSquared);
+        }
 
-    glPushMatrix();
-    float scale = 0.2f; 
-    glScalef(scale, scale, scale);
+        // Se guarda cada cara original y se triangula en abanico (las caras de los FBX son convexas).
+        // Los puntos y líneas sueltos no forman triángulos y se descartan.
+        data.faceSizes.reserve(mesh->mNumFaces);
+        data.faceIndices.reserve(mesh->mNumFaces * 4);
+        data.indices.reserve(mesh->mNumFaces * 3);
+        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
+            const aiFace& face = mesh->mFaces[j];
+            if (face.mNumIndices < 3) continue;
 
-    glLineWidth(3.0f); 
-    glColor3f(1.0f, 0.0f, 0.0f);
+            data.faceSizes.push_back(face.mNumIndices);
+            data.faceIndices.insert(data.faceIndices.end(), face.mIndices, face.mIndices + face.mNumIndices);
 
-    glBegin(GL_LINES);
-    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[i];
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            aiFace& face = mesh->mFaces[j];
-            for (unsigned int k = 0; k < face.mNumIndices; k++) {
-                unsigned int index1 = face.mIndices[k];
-                unsigned int index2 = face.mIndices[(k + 1) % face.mNumIndices];
-                aiVector3D vertex1 = mesh->mVertices[index1];
-                aiVector3D vertex2 = mesh->mVertices[index2];
-
-                glVertex3f(vertex1.x, vertex1.y, vertex1.z);
-                glVertex3f(vertex2.x, vertex2.y, vertex2.z);
+            for (unsigned int k = 1; k + 1 < face.mNumIndices; k++) {
+                data.indices.push_back(face.mIndices[0]);
+                data.indices.push_back(face.mIndices[k]);
+                data.indices.push_back(face.mIndices[k + 1]);
             }
         }
     }
-    glEnd();
 
-    glLineWidth(1.0f); 
-    glColor3f(1.0f, 1.0f, 1.0f); 
+    return true;
+}
 
-    glPopMatrix();
+void ModelLoader::drawModel() {
+    if (resource) {
+        drawMeshes();
+    }
+    else if (!primitiveVertices.empty()) {
+        drawPrimitive();
+    }
 }
 
+void ModelLoader::drawMeshes() {
+    glPushMatrix();
+    glScalef(MODEL_SCALE, MODEL_SCALE, MODEL_SCALE);
 
-// Función para dibujar las normales de las caras, si el modelo tiene quads se dibujan las normales de los quads, si no, se dibujan las normales de las caras como la función anterior
-void ModelLoader::drawFaceNormals() {
-    if (!scene) return;
+    for (const Mesh& mesh : resource->getMeshes()) {
+        mesh.draw();
+    }
 
-    glPushMatrix();
-    float scale = 0.2f; 
-    glScalef(scale, scale, scale);
-
-    glLineWidth(3.0f); 
-    glColor3f(0.0f, 1.0f, 0.0f);
-
-    glBegin(GL_LINES);
-    if (!originalQuads.empty()) {
-        for (const auto& quad : originalQuads) {
-            for (unsigned int k = 0; k < 4; k++) {
-                unsigned int index1 = quad[k];
-                unsigned int index2 = quad[(k + 1) % 4];
-                aiVector3D vertex1 = scene->mMeshes[0]->mVertices[index1];
-                aiVector3D vertex2 = scene->mMeshes[0]->mVertices[index2];
-
-                glVertex3f(vertex1.x, vertex1.y, vertex1.z);
-                glVertex3f(vertex2.x, vertex2.y, vertex2.z);
-            }
-        }
-    } else {
-        for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
-            aiMesh* mesh = scene->mMeshes[i];
-            for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-                aiFace& face = mesh->mFaces[j];
-                for (unsigned int k = 0; k < face.mNumIndices; k++) {
-                    unsigned int index1 = face.mIndices[k];
-                    unsigned int index2 = face.mIndices[(k + 1) % face.mNumIndices];
-                    aiVector3D vertex1 = mesh->mVertices[index1];
-                    aiVector3D vertex2 = mesh->mVertices[index2];
-
-                    glVertex3f(vertex1.x, vertex1.y, vertex1.z);
-                    glVertex3f(vertex2.x, vertex2.y, vertex2.z);
-                }
-            }
-        }
+    glPopMatrix();
+}
+
+void ModelLoader::drawPrimitive() {
+    glBegin(GL_TRIANGLES);
+    for (const auto& vertex : primitiveVertices) {
+        glNormal3f(vertex.nx, vertex.ny, vertex.nz);
+        glTexCoord2f(vertex.u, vertex.v);
+        glVertex3f(vertex.x, vertex.y, vertex.z);
     }
     glEnd();
+}
 
-    glLineWidth(1.0f); 
-    glColor3f(1.0f, 1.0f, 1.0f); 
+void ModelLoader::setShowVertexNormals(bool show) {
+    showVertexNormals = show;
+}
 
-    glPopMatrix();
+void ModelLoader::setShowFaceNormals(bool show) {
+    showFaceNormals = show;
 }
+
@@ -3,43 +3,62 @@
 
 #include <string>
 #include <vector>
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-
-struct Vertex {
-    float x, y, z;    // Posición
-    float nx, ny, nz; // Normales
-    float u, v;       // Coordenadas UV
-};
+#include <memory>
+#include "Mesh.h"
+
+class MeshResource;
+class CookedMeshFile;
 
 class ModelLoader {
 public:
+    // Escala con la que se dibujan los modelos importados
+    static constexpr float MODEL_SCALE = 0.2f;
+
     ModelLoader();
     ~ModelLoader();
     bool loadModel(const std::string& path);
     void drawModel();
-    const aiScene* getScene() const;
 
-    bool isShowingTriangleNormals() const { return showTriangleNormals; }
+    // Etapa en CPU, segura para los hilos de carga: mapea el fichero cocinado (cooked) o, si no está al día,
+    // importa y cocina el FBX (out). Solo se rellena uno de los dos.
+    static bool readMeshes(const std::string& path, std::vector<MeshData>& out, std::unique_ptr<CookedMeshFile>& cooked);
+
+    // Asigna una geometría ya subida a la GPU, compartida con los demás objetos del mismo asset
+    void setMesh(std::shared_ptr<const MeshResource> mesh);
+    const std::shared_ptr<const MeshResource>& getMesh() const { return resource; }
+
+    size_t getMeshCount() const;
+    const std::vector<MeshData>& getMeshData() const;
+
+    // Envolventes en el espacio del GameObject, ya con MODEL_SCALE aplicada; vacías si no hay malla
+    AABB getLocalAABB() const;
+    BoundingSphere getLocalSphere() const;
+
+    // Las normales las dibuja el Renderer desde las líneas precalculadas del MeshResource
+    bool isShowingVertexNormals() const { return showVertexNormals; }
     bool isShowingFaceNormals() const { return showFaceNormals; }
+    bool isShowingNormals() const { return showVertexNormals || showFaceNormals; }
 
-    void setShowTriangleNormals(bool show);
+    void setShowVertexNormals(bool show);
     void setShowFaceNormals(bool show);
 
+    // Longitud de las líneas de normales en el espacio del GameObject (ya con MODEL_SCALE)
+    float getNormalLength() const { return normalLength; }
+    void setNormalLength(float length) { normalLength = length; }
+
 private:
-    void drawNode(aiNode* node, const aiScene* scene);
+    void drawMeshes();
     void drawPrimitive();
-    void drawTriangleNormals(); 
-    void drawFaceNormals();    
 
-    Assimp::Importer importer;
-    const aiScene* scene;
+    // Importa el FBX con Assimp (solo se usa para cocinar)
+    static bool importModel(const std::string& path, std::vector<MeshData>& out);
+
     std::vector<Vertex> primitiveVertices;
+    std::shared_ptr<const MeshResource> resource; // Geometría compartida (CPU y GPU) del asset
 
-    bool showTriangleNormals = false; // Variable para normales de triángulo
-    bool showFaceNormals = false;     // Variable para normales de cara
-    std::vector<std::vector<unsigned int>> originalQuads;
+    bool showVertexNormals = false; // Variable para normales de vértice
+    bool showFaceNormals = false;   // Variable para normales de cara
+    float normalLength = 0.1f;
 };
 
 #endif // MODELLOADER_H
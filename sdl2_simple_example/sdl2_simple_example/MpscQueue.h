@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Cola acotada sin bloqueos para varios productores y un único consumidor. Cada celda lleva un número de
+// secuencia que dice de quién es el turno: los productores se reservan una posición con un compare-exchange y
+// publican la celda con un store; el consumidor solo lee y libera. Si está llena, TryPush falla en vez de esperar.
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "La capacidad debe ser potencia de dos");
+
+public:
+    MpscQueue() : cells(new Cell[Capacity]) {
+        for (size_t i = 0; i < Capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Cualquier hilo
+    bool TryPush(T&& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = intptr_t(sequence) - intptr_t(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            else if (difference < 0) {
+                return false;  // El consumidor aún no ha liberado esta celda: llena
+            }
+            else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Solo el hilo consumidor
+    bool TryPop(T& out) {
+        Cell& cell = cells[dequeuePosition & MASK];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (intptr_t(sequence) - intptr_t(dequeuePosition + 1) < 0) return false;
+
+        out = std::move(cell.value);
+        cell.sequence.store(dequeuePosition + Capacity, std::memory_order_release);
+        dequeuePosition++;
+        return true;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePosition{ 0 };
+    alignas(64) size_t dequeuePosition = 0;  // Separado de la posición de los productores para no compartir línea de caché
+};
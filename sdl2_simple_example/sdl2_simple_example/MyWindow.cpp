@@ -10,6 +10,7 @@
 #include <vector>
 #include <iostream>
 #include "Logger.h"
+#include "AssetLoader.h"
 
 extern std::vector<std::unique_ptr<GameObject>> gameObjects;
 
@@ -21,15 +22,23 @@ MyWindow::MyWindow(const std::string& title, int w, int h) : _width(w), _height(
     SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
     SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
     SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+    // 3.3 para el camino con shaders del Renderer, en perfil de compatibilidad para que el pipeline fijo siga
+    // disponible como alternativa; si el driver no lo da se pide el 3.0 de siempre
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
     _window = SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, w, h, SDL_WINDOW_OPENGL);
     if (!_window) throw exception(SDL_GetError());
 
     _ctx = SDL_GL_CreateContext(_window);
+    if (!_ctx) {
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, 0);
+        _ctx = SDL_GL_CreateContext(_window);
+    }
     if (!_ctx) throw exception(SDL_GetError());
     if (SDL_GL_MakeCurrent(_window, _ctx) != 0) throw exception(SDL_GetError());
-    if (SDL_GL_SetSwapInterval(1) != 0) throw exception(SDL_GetError());
+    // El intervalo de intercambio lo fija el FramePacer según el modo de ritmo
 
     ImGui::CreateContext();
     ImGui_ImplSDL2_InitForOpenGL(_window, _ctx);
@@ -48,28 +57,8 @@ MyWindow::~MyWindow() {
     SDL_DestroyWindow(static_cast<SDL_Window*>(_window));
 }
 
+// La interfaz ya se dibujó en el frame único de ImGui (UIFrame); aquí solo se presenta
 void MyWindow::swapBuffers() const {
-    //Menu Ajustes
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplSDL2_NewFrame();
-    ImGui::NewFrame();
-
-    if (ImGui::BeginMainMenuBar()) {
-        if (ImGui::BeginMenu("Menu")) {
-            if (ImGui::MenuItem("Quit")) {
-                SDL_Event quit_event;
-                quit_event.type = SDL_QUIT;
-                SDL_PushEvent(&quit_event);
-            }
-            ImGui::EndMenu();
-        }
-        ImGui::EndMainMenuBar();
-    }
-
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-
     SDL_GL_SwapWindow(static_cast<SDL_Window*>(_window));
 }
 
@@ -84,16 +73,16 @@ void MyWindow::handleFileDrop(const char* filePath, HierarchyPanel& hierarchyPan
 
     if (extension == "fbx") {
         std::cout << "File dropped: " << filePath << std::endl;
-        auto gameObject = std::make_unique<GameObject>();
-        if (gameObject->loadModel(filePath)) {
+        // La importación se hace en segundo plano; el objeto se añade a la escena cuando está subido
+        AssetLoader::GetInstance().QueueModel(path, [](std::unique_ptr<GameObject> gameObject) {
             gameObjects.push_back(std::move(gameObject));
-        }
+        });
     } else if (extension == "png" || extension == "dds") {
         GameObject* selectedGameObject = hierarchyPanel.getSelectedGameObject();
         if (selectedGameObject) {
             Material& material = selectedGameObject->getMaterial();
             if (material.loadTexture(filePath)) {
-                std::cout << "Texture loaded and set successfully: " << filePath << std::endl;
+                std::cout << "Texture queued: " << filePath << std::endl;
             } else {
                 std::cout << "Failed to load texture: " << filePath << std::endl;
             }
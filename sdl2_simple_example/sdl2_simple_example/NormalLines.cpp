@@ -0,0 +1,243 @@
+#include <GL/glew.h>
+#include "NormalLines.h"
+#include <emmintrin.h>
+#include <cmath>
+#include <utility>
+
+// Vértices de la esquina corner de cuatro triángulos seguidos, uno por carril
+static inline void GatherCorner(const Vertex* vertices, const unsigned int* triangles, size_t corner, __m128& x, __m128& y, __m128& z) {
+    const Vertex& a = vertices[triangles[corner]];
+    const Vertex& b = vertices[triangles[3 + corner]];
+    const Vertex& c = vertices[triangles[6 + corner]];
+    const Vertex& d = vertices[triangles[9 + corner]];
+    x = _mm_setr_ps(a.x, b.x, c.x, d.x);
+    y = _mm_setr_ps(a.y, b.y, c.y, d.y);
+    z = _mm_setr_ps(a.z, b.z, c.z, d.z);
+}
+
+// Producto vectorial (sin normalizar: su longitud es el doble del área) de las dos aristas de cada triángulo
+static void TriangleCrossProducts(const MeshData& data, std::vector<float>& crossX, std::vector<float>& crossY, std::vector<float>& crossZ) {
+    size_t triangleCount = data.indices.size() / 3;
+    crossX.resize(triangleCount);
+    crossY.resize(triangleCount);
+    crossZ.resize(triangleCount);
+
+    const Vertex* vertices = data.vertices.data();
+    const unsigned int* indices = data.indices.data();
+    size_t t = 0;
+    for (; t + 4 <= triangleCount; t += 4) {
+        __m128 x0, y0, z0, x1, y1, z1, x2, y2, z2;
+        GatherCorner(vertices, indices + 3 * t, 0, x0, y0, z0);
+        GatherCorner(vertices, indices + 3 * t, 1, x1, y1, z1);
+        GatherCorner(vertices, indices + 3 * t, 2, x2, y2, z2);
+
+        __m128 ax = _mm_sub_ps(x1, x0), ay = _mm_sub_ps(y1, y0), az = _mm_sub_ps(z1, z0);
+        __m128 bx = _mm_sub_ps(x2, x0), by = _mm_sub_ps(y2, y0), bz = _mm_sub_ps(z2, z0);
+        _mm_storeu_ps(&crossX[t], _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+        _mm_storeu_ps(&crossY[t], _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+        _mm_storeu_ps(&crossZ[t], _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+    }
+    for (; t < triangleCount; t++) {
+        const Vertex& v0 = vertices[indices[3 * t]];
+        const Vertex& v1 = vertices[indices[3 * t + 1]];
+        const Vertex& v2 = vertices[indices[3 * t + 2]];
+        float ax = v1.x - v0.x, ay = v1.y - v0.y, az = v1.z - v0.z;
+        float bx = v2.x - v0.x, by = v2.y - v0.y, bz = v2.z - v0.z;
+        crossX[t] = ay * bz - az * by;
+        crossY[t] = az * bx - ax * bz;
+        crossZ[t] = ax * by - ay * bx;
+    }
+}
+
+// Normaliza count vectores guardados por componentes. Los de longitud casi nula (caras degeneradas) quedan a cero.
+static void NormalizeBatch(float* x, float* y, float* z, size_t count) {
+    const __m128 epsilon = _mm_set1_ps(1e-20f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i);
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+
+        // Inversa de la raíz aproximada y un paso de Newton-Raphson: r' = r * (3 - l² r²) / 2
+        __m128 r = _mm_rsqrt_ps(lengthSquared);
+        r = _mm_mul_ps(_mm_mul_ps(half, r), _mm_sub_ps(three, _mm_mul_ps(lengthSquared, _mm_mul_ps(r, r))));
+        r = _mm_and_ps(r, _mm_cmpgt_ps(lengthSquared, epsilon));
+
+        _mm_storeu_ps(x + i, _mm_mul_ps(vx, r));
+        _mm_storeu_ps(y + i, _mm_mul_ps(vy, r));
+        _mm_storeu_ps(z + i, _mm_mul_ps(vz, r));
+    }
+    for (; i < count; i++) {
+        float lengthSquared = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        float r = lengthSquared > 1e-20f ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+        x[i] *= r;
+        y[i] *= r;
+        z[i] *= r;
+    }
+}
+
+void NormalLines::ComputeLines(const MeshData& data, std::vector<NormalLineVertex>& out, size_t& faceVertexCount) {
+    out.clear();
+    faceVertexCount = 0;
+
+    std::vector<float> crossX, crossY, crossZ;
+    TriangleCrossProducts(data, crossX, crossY, crossZ);
+    size_t triangleCount = crossX.size();
+
+    // Los triángulos salen del abanico de cada cara original, en orden: la cara f ocupa faceSizes[f] - 2
+    // triángulos seguidos. Si no cuadra, cada triángulo cuenta como una cara.
+    size_t fanTriangles = 0;
+    for (unsigned int size : data.faceSizes) {
+        fanTriangles += size >= 3 ? size - 2 : 0;
+    }
+    bool useFaces = !data.faceSizes.empty() && fanTriangles == triangleCount;
+    size_t faceCount = useFaces ? data.faceSizes.size() : triangleCount;
+
+    std::vector<float> faceX(faceCount), faceY(faceCount), faceZ(faceCount);
+    std::vector<float> centerX(faceCount), centerY(faceCount), centerZ(faceCount);
+    size_t triangle = 0;
+    size_t corner = 0;
+    for (size_t f = 0; f < faceCount; f++) {
+        size_t corners = useFaces ? data.faceSizes[f] : 3;
+        size_t triangles = corners >= 3 ? corners - 2 : 0;
+        const unsigned int* faceIndices = useFaces ? &data.faceIndices[corner] : &data.indices[3 * f];
+
+        // Sumar los productos sin normalizar pondera cada triángulo por su área
+        float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+        for (size_t t = triangle; t < triangle + triangles; t++) {
+            sumX += crossX[t];
+            sumY += crossY[t];
+            sumZ += crossZ[t];
+        }
+        faceX[f] = sumX;
+        faceY[f] = sumY;
+        faceZ[f] = sumZ;
+
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        for (size_t k = 0; k < corners; k++) {
+            const Vertex& vertex = data.vertices[faceIndices[k]];
+            x += vertex.x;
+            y += vertex.y;
+            z += vertex.z;
+        }
+        centerX[f] = x / float(corners);
+        centerY[f] = y / float(corners);
+        centerZ[f] = z / float(corners);
+
+        triangle += triangles;
+        corner += corners;
+    }
+    NormalizeBatch(faceX.data(), faceY.data(), faceZ.data(), faceCount);
+
+    // Normales de vértice: las del fichero; a los vértices que no traen se les da la media de sus triángulos
+    size_t vertexCount = data.vertices.size();
+    std::vector<float> normalX(vertexCount, 0.0f), normalY(vertexCount, 0.0f), normalZ(vertexCount, 0.0f);
+    bool missingNormals = false;
+    for (size_t v = 0; v < vertexCount; v++) {
+        const Vertex& vertex = data.vertices[v];
+        normalX[v] = vertex.nx;
+        normalY[v] = vertex.ny;
+        normalZ[v] = vertex.nz;
+        missingNormals = missingNormals || (vertex.nx == 0.0f && vertex.ny == 0.0f && vertex.nz == 0.0f);
+    }
+    if (missingNormals) {
+        std::vector<float> sumX(vertexCount, 0.0f), sumY(vertexCount, 0.0f), sumZ(vertexCount, 0.0f);
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (size_t k = 0; k < 3; k++) {
+                unsigned int index = data.indices[3 * t + k];
+                sumX[index] += crossX[t];
+                sumY[index] += crossY[t];
+                sumZ[index] += crossZ[t];
+            }
+        }
+        for (size_t v = 0; v < vertexCount; v++) {
+            if (normalX[v] == 0.0f && normalY[v] == 0.0f && normalZ[v] == 0.0f) {
+                normalX[v] = sumX[v];
+                normalY[v] = sumY[v];
+                normalZ[v] = sumZ[v];
+            }
+        }
+    }
+    NormalizeBatch(normalX.data(), normalY.data(), normalZ.data(), vertexCount);
+
+    out.reserve(2 * (faceCount + vertexCount));
+    for (size_t f = 0; f < faceCount; f++) {
+        NormalLineVertex line = { centerX[f], centerY[f], centerZ[f], faceX[f], faceY[f], faceZ[f] };
+        out.push_back(line);
+        out.push_back(line);
+    }
+    faceVertexCount = out.size();
+    for (size_t v = 0; v < vertexCount; v++) {
+        const Vertex& vertex = data.vertices[v];
+        NormalLineVertex line = { vertex.x, vertex.y, vertex.z, normalX[v], normalY[v], normalZ[v] };
+        out.push_back(line);
+        out.push_back(line);
+    }
+}
+
+NormalLines::~NormalLines() {
+    release();
+}
+
+NormalLines::NormalLines(NormalLines&& other) noexcept
+    : vao(other.vao), vbo(other.vbo), faceVertexCount(other.faceVertexCount), vertexVertexCount(other.vertexVertexCount) {
+    other.vao = other.vbo = 0;
+    other.faceVertexCount = other.vertexVertexCount = 0;
+}
+
+NormalLines& NormalLines::operator=(NormalLines&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(vao, other.vao);
+        std::swap(vbo, other.vbo);
+        std::swap(faceVertexCount, other.faceVertexCount);
+        std::swap(vertexVertexCount, other.vertexVertexCount);
+    }
+    return *this;
+}
+
+void NormalLines::build(const MeshData& data) {
+    release();
+
+    std::vector<NormalLineVertex> lines;
+    size_t faceVertices = 0;
+    ComputeLines(data, lines, faceVertices);
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, lines.size() * sizeof(NormalLineVertex), lines.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(Mesh::POSITION_LOCATION);
+    glVertexAttribPointer(Mesh::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(NormalLineVertex),
+                          reinterpret_cast<void*>(offsetof(NormalLineVertex, x)));
+    glEnableVertexAttribArray(Mesh::NORMAL_LOCATION);
+    glVertexAttribPointer(Mesh::NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(NormalLineVertex),
+                          reinterpret_cast<void*>(offsetof(NormalLineVertex, nx)));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    faceVertexCount = static_cast<unsigned int>(faceVertices);
+    vertexVertexCount = static_cast<unsigned int>(lines.size() - faceVertices);
+}
+
+void NormalLines::draw(bool faceNormals, bool vertexNormals) const {
+    GLsizei count = GLsizei((faceNormals ? faceVertexCount : 0) + (vertexNormals ? vertexVertexCount : 0));
+    if (!vao || count == 0) return;
+
+    glBindVertexArray(vao);
+    glDrawArrays(GL_LINES, faceNormals ? 0 : GLint(faceVertexCount), count);
+    glBindVertexArray(0);
+}
+
+void NormalLines::release() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    vao = vbo = 0;
+    faceVertexCount = vertexVertexCount = 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Mesh.h"
+
+// Vértice de una línea de normal: el punto de apoyo y la normal unitaria. Los dos extremos de cada línea llevan
+// los mismos datos; el shader alarga el segundo (gl_VertexID impar) con la longitud pedida, así que cambiar la
+// longitud no obliga a recalcular nada.
+struct NormalLineVertex {
+    float x, y, z;
+    float nx, ny, nz;
+};
+
+// Normales de una malla como líneas en la GPU, calculadas una sola vez. En el buffer van primero las de cada
+// cara original (desde su centro) y detrás las de cada vértice, para que con las dos activadas el tramo a
+// dibujar sea contiguo: una sola llamada por malla en cualquier caso.
+class NormalLines {
+public:
+    NormalLines() = default;
+    ~NormalLines();
+
+    NormalLines(NormalLines&& other) noexcept;
+    NormalLines& operator=(NormalLines&& other) noexcept;
+    NormalLines(const NormalLines&) = delete;
+    NormalLines& operator=(const NormalLines&) = delete;
+
+    // Calcula las líneas en CPU y las sube
+    void build(const MeshData& data);
+    void release();
+
+    void draw(bool faceNormals, bool vertexNormals) const;
+
+    bool isBuilt() const { return vao != 0; }
+    // Vértices de las líneas de cara; a partir de aquí empiezan las de vértice
+    unsigned int getFaceVertexCount() const { return faceVertexCount; }
+
+    // Núcleo en CPU: normales de cara (media ponderada por área de los triángulos de la cara) y de vértice (las
+    // del fichero o, si no trae, la media de los triángulos que lo usan), con los productos vectoriales y las
+    // normalizaciones de cuatro en cuatro con SSE. faceVertexCount recibe cuántos vértices de out son de caras.
+    static void ComputeLines(const MeshData& data, std::vector<NormalLineVertex>& out, size_t& faceVertexCount);
+
+private:
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    unsigned int faceVertexCount = 0;
+    unsigned int vertexVertexCount = 0;
+};
@@ -0,0 +1,209 @@
+#include <GL/glew.h>
+#include "Profiler.h"
+#include <chrono>
+#include <fstream>
+#include <set>
+
+// Profundidad de las zonas abiertas e identificador de cada hilo
+static thread_local int cpuDepth = 0;
+static thread_local uint32_t threadId = 0;
+
+static int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::Profiler() : epochNs(SteadyNowNs()) {}
+
+int64_t Profiler::Now() const {
+    return SteadyNowNs() - epochNs;
+}
+
+uint32_t Profiler::GetThreadId() {
+    if (threadId == 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threadId = nextThreadId++;
+    }
+    return threadId;
+}
+
+void Profiler::BeginFrame() {
+    mainThread = GetThreadId();
+    if (gpuState == GpuState::READY) {
+        ResolveGpuZones();
+    }
+
+    int64_t now = Now();
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t nextIndex = current.index + 1;
+    if (frameStarted) {
+        current.endNs = now;
+        history.push_back(std::move(current));
+        if (history.size() > HISTORY_SIZE) history.pop_front();
+    }
+
+    current = ProfileFrame();
+    current.index = nextIndex;
+    current.startNs = now;
+    current.mainThread = mainThread;
+    frameStarted = true;
+}
+
+int64_t Profiler::BeginCpuZone() {
+    if (!enabled) return -1;
+    cpuDepth++;
+    return Now();
+}
+
+void Profiler::EndCpuZone(const char* name, int64_t startNs) {
+    if (startNs < 0) return;
+    cpuDepth--;
+
+    ProfileEvent event = { name, startNs, Now(), cpuDepth, GetThreadId() };
+    std::lock_guard<std::mutex> lock(mutex);
+    current.cpuEvents.push_back(event);
+}
+
+bool Profiler::InitGpuTiming() {
+    if (gpuState != GpuState::UNINITIALIZED) return gpuState == GpuState::READY;
+
+    gpuState = GpuState::UNSUPPORTED;
+    if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query) return false;
+
+    // Las marcas de la GPU van en su propio reloj: se alinean con el del profiler con una lectura de cada uno
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    gpuOffsetNs = Now() - int64_t(gpuNow);
+    gpuState = GpuState::READY;
+    return true;
+}
+
+unsigned int Profiler::AllocateQuery() {
+    if (freeQueries.empty()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        return query;
+    }
+    unsigned int query = freeQueries.back();
+    freeQueries.pop_back();
+    return query;
+}
+
+int64_t Profiler::BeginGpuZone(const char* name) {
+    if (!enabled || !InitGpuTiming()) return -1;
+
+    GpuZone zone = { name, gpuDepth++, 0, AllocateQuery(), AllocateQuery(), false };
+    glQueryCounter(zone.beginQuery, GL_TIMESTAMP);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        zone.frame = current.index;
+        current.pendingGpuZones++;
+    }
+    gpuZones.push_back(zone);
+    return firstGpuZone + int64_t(gpuZones.size()) - 1;
+}
+
+void Profiler::EndGpuZone(int64_t id) {
+    if (id < 0) return;
+
+    GpuZone& zone = gpuZones[size_t(id - firstGpuZone)];
+    glQueryCounter(zone.endQuery, GL_TIMESTAMP);
+    zone.ended = true;
+    gpuDepth--;
+}
+
+// Las consultas se resuelven en el orden en que se emitieron: se recogen las que ya están listas, sin bloquear,
+// y se para en la primera que la GPU aún no ha alcanzado
+void Profiler::ResolveGpuZones() {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!gpuZones.empty()) {
+        GpuZone& zone = gpuZones.front();
+        if (!zone.ended) break;
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(zone.endQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(zone.beginQuery, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(zone.endQuery, GL_QUERY_RESULT, &end);
+        if (ProfileFrame* frame = FindFrame(zone.frame)) {
+            frame->gpuEvents.push_back({ zone.name, int64_t(begin) + gpuOffsetNs, int64_t(end) + gpuOffsetNs, zone.depth, GPU_THREAD });
+            frame->pendingGpuZones--;
+        }
+
+        freeQueries.push_back(zone.beginQuery);
+        freeQueries.push_back(zone.endQuery);
+        gpuZones.pop_front();
+        firstGpuZone++;
+    }
+}
+
+ProfileFrame* Profiler::FindFrame(uint64_t index) {
+    if (index == current.index) return &current;
+    if (history.empty() || index < history.front().index || index > history.back().index) return nullptr;
+    return &history[size_t(index - history.front().index)];
+}
+
+bool Profiler::GetLastCompleteFrame(ProfileFrame& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = history.rbegin(); it != history.rend(); ++it) {
+        if (it->isComplete()) {
+            out = *it;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void WriteEscaped(std::ofstream& out, const char* text) {
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+}
+
+// Formato "Trace Event": eventos completos (ph X) con inicio y duración en microsegundos y un tid por hilo;
+// la GPU va como un hilo más (tid 0)
+bool Profiler::ExportChromeTrace(const std::string& path) const {
+    std::deque<ProfileFrame> frames;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames = history;
+    }
+
+    std::ofstream out(path);
+    if (!out) return false;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+
+    bool first = true;
+    std::set<uint32_t> threads;
+    auto writeEvent = [&](const char* name, const char* category, uint32_t thread, int64_t startNs, int64_t endNs) {
+        uint32_t tid = thread == GPU_THREAD ? 0 : thread;
+        threads.insert(tid);
+        out << (first ? "\n" : ",\n") << "{\"name\":\"";
+        WriteEscaped(out, name);
+        out << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+            << ",\"ts\":" << double(startNs) / 1000.0 << ",\"dur\":" << double(endNs - startNs) / 1000.0 << "}";
+        first = false;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (const ProfileFrame& frame : frames) {
+        writeEvent("Frame", "frame", frame.mainThread, frame.startNs, frame.endNs);
+        for (const ProfileEvent& event : frame.cpuEvents) {
+            writeEvent(event.name, "cpu", event.thread, event.startNs, event.endNs);
+        }
+        for (const ProfileEvent& event : frame.gpuEvents) {
+            writeEvent(event.name, "gpu", event.thread, event.startNs, event.endNs);
+        }
+    }
+    for (uint32_t tid : threads) {
+        const char* name = tid == 0 ? "GPU" : tid == mainThread ? "Main thread" : "Loader thread";
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+            << ",\"args\":{\"name\":\"" << name << "\"}}";
+        first = false;
+    }
+    out << "\n]}\n";
+    return bool(out);
+}
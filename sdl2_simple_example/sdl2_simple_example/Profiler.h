@@ -0,0 +1,140 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Zona medida: intervalo en nanosegundos desde que arrancó el profiler. Los nombres son literales (no se copian).
+struct ProfileEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t endNs;
+    int depth;        // Anidamiento dentro de su hilo (o de la GPU)
+    uint32_t thread;  // Identificador propio del profiler; GPU_THREAD para las zonas de GPU
+};
+
+// Todo lo medido durante un frame del hilo principal. Las zonas de GPU llegan unos frames más tarde, cuando los
+// resultados de las consultas están listos; hasta entonces pendingGpuZones es mayor que cero.
+struct ProfileFrame {
+    uint64_t index = 0;
+    int64_t startNs = 0;
+    int64_t endNs = 0;
+    uint32_t mainThread = 0;  // Hilo que abre y cierra los frames
+    std::vector<ProfileEvent> cpuEvents;
+    std::vector<ProfileEvent> gpuEvents;
+    int pendingGpuZones = 0;
+
+    bool isComplete() const { return endNs > 0 && pendingGpuZones == 0; }
+};
+
+// Profiler jerárquico de CPU y GPU. Las zonas de CPU se abren con PROFILE_SCOPE desde cualquier hilo; las de GPU
+// (PROFILE_GPU_SCOPE, solo en el hilo del contexto) ponen consultas de marca de tiempo de OpenGL y se leen sin
+// esperar a la GPU. Guarda los últimos frames para el panel de llamas y para exportarlos como traza de Chrome.
+class Profiler {
+public:
+    static constexpr uint32_t GPU_THREAD = 0xFFFFFFFFu;
+
+    static Profiler& GetInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    // Cierra el frame anterior y abre uno nuevo; lo llama el bucle principal al empezar cada frame
+    void BeginFrame();
+
+    bool IsEnabled() const { return enabled; }
+    void SetEnabled(bool enable) { enabled = enable; }
+
+    // Usados por las zonas; devuelven -1 si no se mide
+    int64_t BeginCpuZone();
+    void EndCpuZone(const char* name, int64_t startNs);
+    int64_t BeginGpuZone(const char* name);
+    void EndGpuZone(int64_t zone);
+
+    bool IsGpuTimingSupported() const { return gpuState == GpuState::READY; }
+
+    // Copia del frame completo (CPU y GPU) más reciente; false si todavía no hay ninguno
+    bool GetLastCompleteFrame(ProfileFrame& out) const;
+
+    // Escribe los frames guardados en el formato JSON de chrome://tracing (y Perfetto)
+    bool ExportChromeTrace(const std::string& path) const;
+
+    int64_t Now() const;
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    enum class GpuState { UNINITIALIZED, READY, UNSUPPORTED };
+
+    // Par de consultas de marca de tiempo de una zona de GPU, pendiente hasta que la GPU las resuelve
+    struct GpuZone {
+        const char* name;
+        int depth;
+        uint64_t frame;
+        unsigned int beginQuery;
+        unsigned int endQuery;
+        bool ended;
+    };
+
+    bool InitGpuTiming();
+    void ResolveGpuZones();
+    uint32_t GetThreadId();
+    unsigned int AllocateQuery();
+    ProfileFrame* FindFrame(uint64_t index);
+
+    static const size_t HISTORY_SIZE = 120;
+
+    std::atomic<bool> enabled{ true };
+    int64_t epochNs;              // Origen de los tiempos, en el reloj estable
+    uint32_t mainThread = 0;
+    uint32_t nextThreadId = 1;
+    bool frameStarted = false;
+
+    mutable std::mutex mutex;     // Protege current e history (las zonas de los hilos de carga entran aquí)
+    ProfileFrame current;
+    std::deque<ProfileFrame> history;
+
+    // GPU: solo desde el hilo principal
+    GpuState gpuState = GpuState::UNINITIALIZED;
+    int64_t gpuOffsetNs = 0;      // Diferencia entre el reloj de la GPU y el del profiler
+    int gpuDepth = 0;
+    std::deque<GpuZone> gpuZones;
+    int64_t firstGpuZone = 0;     // Identificador de gpuZones.front()
+    std::vector<unsigned int> freeQueries;
+};
+
+// Zona de CPU: mide desde su construcción hasta el final del bloque
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), startNs(Profiler::GetInstance().BeginCpuZone()) {}
+    ~ProfileScope() { Profiler::GetInstance().EndCpuZone(name, startNs); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    int64_t startNs;
+};
+
+// Zona de GPU: mide lo que tarda la GPU en ejecutar los comandos emitidos dentro del bloque
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name) : zone(Profiler::GetInstance().BeginGpuZone(name)) {}
+    ~GpuProfileScope() { Profiler::GetInstance().EndGpuZone(zone); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    int64_t zone;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
@@ -0,0 +1,133 @@
+#include "ProfilerPanel.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <set>
+
+static const char* TRACE_PATH = "profile_trace.json";
+static const float ROW_HEIGHT = 18.0f;
+static const float LABEL_WIDTH = 90.0f;
+
+ProfilerPanel::ProfilerPanel() {}
+ProfilerPanel::~ProfilerPanel() {}
+
+// Color estable por nombre de zona, para reconocerla de un frame a otro
+static ImU32 GetZoneColor(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; c++) {
+        hash = (hash ^ uint8_t(*c)) * 16777619u;
+    }
+    return IM_COL32(90 + (hash & 0x7F), 90 + ((hash >> 8) & 0x7F), 90 + ((hash >> 16) & 0x7F), 255);
+}
+
+void ProfilerPanel::Render() {
+    Profiler& profiler = Profiler::GetInstance();
+
+    ImGui::Begin("Profiler");
+
+    bool enabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+        profiler.SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        if (profiler.ExportChromeTrace(TRACE_PATH)) {
+            LOG_FORMAT(INFO, "Traza del profiler guardada en %s", TRACE_PATH);
+        }
+        else {
+            LOG_FORMAT(WARNING, "No se pudo escribir la traza del profiler en %s", TRACE_PATH);
+        }
+    }
+
+    if (!profiler.IsGpuTimingSupported()) {
+        ImGui::TextDisabled("GPU timing not available (needs GL 3.3 or ARB_timer_query)");
+    }
+
+    if (!paused) {
+        hasFrame = profiler.GetLastCompleteFrame(frame) || hasFrame;
+    }
+    if (!hasFrame) {
+        ImGui::Text("Waiting for a complete frame...");
+        ImGui::End();
+        return;
+    }
+
+    // La GPU puede terminar después de que el hilo principal haya cerrado el frame
+    int64_t endNs = frame.endNs;
+    for (const ProfileEvent& event : frame.gpuEvents) {
+        endNs = std::max(endNs, event.endNs);
+    }
+    int64_t spanNs = std::max<int64_t>(endNs - frame.startNs, 1);
+    ImGui::Text("Frame %llu: %.2f ms CPU, %.2f ms including GPU", (unsigned long long)frame.index,
+                double(frame.endNs - frame.startNs) / 1e6, double(spanNs) / 1e6);
+    ImGui::Separator();
+
+    // Primero el hilo principal, luego la GPU y después los hilos de carga que hayan medido algo en este frame
+    std::set<uint32_t> loaderThreads;
+    for (const ProfileEvent& event : frame.cpuEvents) {
+        if (event.thread != frame.mainThread) loaderThreads.insert(event.thread);
+    }
+
+    RenderTrack("Main", frame, frame.cpuEvents, frame.mainThread, spanNs);
+    RenderTrack("GPU", frame, frame.gpuEvents, Profiler::GPU_THREAD, spanNs);
+    int loaderIndex = 1;
+    for (uint32_t thread : loaderThreads) {
+        char label[32];
+        snprintf(label, sizeof(label), "Loader %d", loaderIndex++);
+        RenderTrack(label, frame, frame.cpuEvents, thread, spanNs);
+    }
+
+    ImGui::End();
+}
+
+void ProfilerPanel::RenderTrack(const char* label, const ProfileFrame& frame, const std::vector<ProfileEvent>& events,
+                                uint32_t thread, int64_t spanNs) {
+    int rows = 1;
+    for (const ProfileEvent& event : events) {
+        if (event.thread == thread) rows = std::max(rows, event.depth + 1);
+    }
+
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = std::max(ImGui::GetContentRegionAvail().x - LABEL_WIDTH, 50.0f);
+    float height = rows * ROW_HEIGHT;
+    float scale = width / float(spanNs);
+    ImVec2 trackMin(origin.x + LABEL_WIDTH, origin.y);
+    ImVec2 trackMax(trackMin.x + width, origin.y + height);
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddText(origin, ImGui::GetColorU32(ImGuiCol_Text), label);
+    drawList->AddRectFilled(trackMin, trackMax, IM_COL32(40, 40, 40, 255));
+    drawList->PushClipRect(trackMin, trackMax, true);
+
+    ImVec2 mouse = ImGui::GetMousePos();
+    const ProfileEvent* hovered = nullptr;
+    for (const ProfileEvent& event : events) {
+        if (event.thread != thread) continue;
+
+        // Las zonas de los hilos de carga pueden empezar antes que el frame: se recortan a su inicio
+        float x0 = trackMin.x + float(std::max<int64_t>(event.startNs - frame.startNs, 0)) * scale;
+        float x1 = std::max(trackMin.x + float(event.endNs - frame.startNs) * scale, x0 + 1.0f);
+        float y0 = trackMin.y + event.depth * ROW_HEIGHT;
+        ImVec2 min(x0, y0);
+        ImVec2 max(x1, y0 + ROW_HEIGHT - 1.0f);
+        drawList->AddRectFilled(min, max, GetZoneColor(event.name));
+
+        ImVec2 textSize = ImGui::CalcTextSize(event.name);
+        if (textSize.x + 4.0f < x1 - x0) {
+            drawList->AddText(ImVec2(x0 + 2.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+        }
+        if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+            hovered = &event;
+        }
+    }
+
+    drawList->PopClipRect();
+    ImGui::Dummy(ImVec2(LABEL_WIDTH + width, height + 4.0f));
+
+    if (hovered && ImGui::IsWindowHovered()) {
+        ImGui::SetTooltip("%s\n%.3f ms (starts at %.3f ms)", hovered->name,
+                          double(hovered->endNs - hovered->startNs) / 1e6, double(hovered->startNs - frame.startNs) / 1e6);
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "imgui.h"
+#include "Profiler.h"
+
+class ProfilerPanel {
+public:
+    ProfilerPanel();
+    ~ProfilerPanel();
+
+    // Gráfico de llamas del último frame completo: una pista por hilo y otra para la GPU
+    void Render();
+
+private:
+    void RenderTrack(const char* label, const ProfileFrame& frame, const std::vector<ProfileEvent>& events,
+                     uint32_t thread, int64_t spanNs);
+
+    bool paused = false;
+    ProfileFrame frame;  // Copia del frame mostrado (se congela mientras está en pausa)
+    bool hasFrame = false;
+};
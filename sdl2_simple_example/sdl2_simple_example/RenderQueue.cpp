@@ -0,0 +1,107 @@
+#include <GL/glew.h>
+#include "RenderQueue.h"
+#include <algorithm>
+
+static const uint64_t TEXTURE_BITS = 14;
+static const uint64_t MESH_BITS = 24;
+static const uint64_t DEPTH_BITS = 24;
+
+void RenderStateCache::reset() {
+    programKnown = textureEnabledKnown = textureKnown = colorKnown = false;
+}
+
+void RenderStateCache::restoreDefaults() {
+    useProgram(0);
+    setTexture(0);
+    setColor(glm::vec3(1.0f));
+}
+
+void RenderStateCache::useProgram(unsigned int newProgram) {
+    if (programKnown && newProgram == program) {
+        stats.saved++;
+        return;
+    }
+    glUseProgram(newProgram);
+    program = newProgram;
+    programKnown = true;
+    stats.issued++;
+}
+
+void RenderStateCache::setTexture(unsigned int textureID) {
+    bool enable = textureID != 0;
+    if (textureEnabledKnown && enable == textureEnabled) {
+        stats.saved++;
+    }
+    else {
+        if (enable) glEnable(GL_TEXTURE_2D);
+        else glDisable(GL_TEXTURE_2D);
+        textureEnabled = enable;
+        textureEnabledKnown = true;
+        stats.issued++;
+    }
+
+    // Sin textura el enlace no importa: se deja el que hubiera
+    if (enable) bindTexture(textureID);
+}
+
+void RenderStateCache::bindTexture(unsigned int textureID) {
+    if (textureKnown && textureID == texture) {
+        stats.saved++;
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    texture = textureID;
+    textureKnown = true;
+    stats.issued++;
+}
+
+void RenderStateCache::setColor(const glm::vec3& newColor) {
+    if (colorKnown && newColor == color) {
+        stats.saved++;
+        return;
+    }
+    glColor3f(newColor.r, newColor.g, newColor.b);
+    color = newColor;
+    colorKnown = true;
+    stats.issued++;
+}
+
+void RenderQueue::clear() {
+    commands.clear();
+    textureSlots.clear();
+    meshSlots.clear();
+}
+
+uint32_t RenderQueue::getTextureSlot(unsigned int textureID) {
+    auto it = textureSlots.find(textureID);
+    if (it != textureSlots.end()) return it->second;
+
+    // Si hubiera más texturas de las que caben, las que sobran comparten el último valor: solo se ordenan peor
+    uint32_t slot = uint32_t(std::min<size_t>(textureSlots.size(), (1u << TEXTURE_BITS) - 1));
+    textureSlots.emplace(textureID, slot);
+    return slot;
+}
+
+uint32_t RenderQueue::getMeshSlot(const void* mesh) {
+    auto it = meshSlots.find(mesh);
+    if (it != meshSlots.end()) return it->second;
+
+    uint32_t slot = uint32_t(std::min<size_t>(meshSlots.size(), (1u << MESH_BITS) - 1));
+    meshSlots.emplace(mesh, slot);
+    return slot;
+}
+
+void RenderQueue::push(Program program, uint32_t textureSlot, uint32_t meshSlot, float depth, uint32_t index) {
+    uint64_t quantizedDepth = uint64_t(std::min(std::max(depth, 0.0f), 1.0f) * float((1u << DEPTH_BITS) - 1));
+    uint64_t key = (uint64_t(program) << (TEXTURE_BITS + MESH_BITS + DEPTH_BITS))
+                 | (uint64_t(textureSlot) << (MESH_BITS + DEPTH_BITS))
+                 | (uint64_t(meshSlot) << DEPTH_BITS)
+                 | quantizedDepth;
+    commands.push_back({ key, index });
+}
+
+void RenderQueue::sort() {
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        return a.key < b.key;
+    });
+}
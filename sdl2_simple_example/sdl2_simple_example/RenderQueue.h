@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+// Contadores de cambios de estado de OpenGL del último frame
+struct BindStats {
+    int issued = 0;  // Llamadas que llegaron a OpenGL
+    int saved = 0;   // Evitadas porque el estado ya era el pedido
+};
+
+// Última copia conocida del estado que cambian los materiales: solo se llama a OpenGL cuando el valor cambia.
+// Al empezar el frame se olvida todo, porque ImGui y el resto del código tocan el estado por su cuenta.
+class RenderStateCache {
+public:
+    void reset();
+    // Deja el estado como lo espera el resto del código: sin programa, sin textura y color blanco
+    void restoreDefaults();
+
+    void useProgram(unsigned int program);
+    // 0 desactiva GL_TEXTURE_2D
+    void setTexture(unsigned int textureID);
+    // Para los shaders: solo enlaza la textura, sin tocar GL_TEXTURE_2D (que en el perfil core no existe)
+    void bindTexture(unsigned int textureID);
+    void setColor(const glm::vec3& color);
+    // Para cuando algo dibuja con glColor por su cuenta (por ejemplo las normales)
+    void invalidateColor() { colorKnown = false; }
+
+    const BindStats& getStats() const { return stats; }
+    void resetStats() { stats = BindStats(); }
+
+private:
+    // Cada parte del estado se conoce por separado: hasta que no se fija una vez, la siguiente llamada se emite
+    bool programKnown = false;
+    bool textureEnabledKnown = false;
+    bool textureKnown = false;
+    bool colorKnown = false;
+    unsigned int program = 0;
+    bool textureEnabled = false;
+    unsigned int texture = 0;
+    glm::vec3 color = glm::vec3(1.0f);
+    BindStats stats;
+};
+
+// Cola de dibujo del frame: cada comando es una clave de 64 bits y el índice de lo que dibuja. Ordenando por
+// la clave quedan juntos los que comparten programa, textura y malla y, dentro de cada grupo, de delante a atrás
+// para que el test de profundidad descarte pronto los fragmentos tapados.
+//   bits 63..62 programa | 61..48 textura | 47..24 malla | 23..0 profundidad
+class RenderQueue {
+public:
+    enum Program : uint64_t { PROGRAM_SINGLE = 0, PROGRAM_INSTANCED = 1 };
+
+    struct Command {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    void clear();
+
+    // Índices densos del frame para texturas y mallas, para que quepan en su campo de la clave
+    uint32_t getTextureSlot(unsigned int textureID);
+    uint32_t getMeshSlot(const void* mesh);
+
+    // depth en [0, 1]: 0 en la cámara
+    void push(Program program, uint32_t textureSlot, uint32_t meshSlot, float depth, uint32_t index);
+    void sort();
+
+    static Program GetProgram(uint64_t key) { return Program(key >> 62); }
+
+    const std::vector<Command>& getCommands() const { return commands; }
+
+private:
+    std::vector<Command> commands;
+    std::unordered_map<unsigned int, uint32_t> textureSlots;
+    std::unordered_map<const void*, uint32_t> meshSlots;
+};
@@ -0,0 +1,349 @@
+#include <GL/glew.h>
+#include "Renderer.h"
+#include "SpatialIndex.h"
+#include "MeshCache.h"
+#include "Camera.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <tuple>
+#include <string>
+
+// La matriz de instancia ocupa cuatro atributos a partir de este. Se evitan los primeros porque algunos drivers
+// los comparten con gl_Vertex, gl_Normal o gl_Color; del 12 al 15 coinciden con coordenadas de textura que no se usan.
+static const unsigned int INSTANCE_MATRIX_LOCATION = 12;
+
+// Para normalizar la profundidad de la cola; el mismo plano lejano que la proyección de la cámara
+static const float FAR_PLANE = Camera::FAR_PLANE;
+
+// La vista y la proyección siguen viniendo de las matrices de OpenGL que carga RenderScene
+static const char* INSTANCED_VERTEX_SHADER = R"(
+#version 130
+in mat4 instanceModel;
+out vec2 texCoord;
+void main() {
+    texCoord = gl_MultiTexCoord0.xy;
+    gl_Position = gl_ProjectionMatrix * (gl_ModelViewMatrix * (instanceModel * gl_Vertex));
+}
+)";
+
+// Igual que Material::use con el pipeline fijo: la textura tal cual o el color por defecto
+static const char* INSTANCED_FRAGMENT_SHADER = R"(
+#version 130
+uniform sampler2D diffuseTexture;
+uniform bool useTexture;
+uniform vec3 color;
+in vec2 texCoord;
+void main() {
+    gl_FragColor = useTexture ? texture2D(diffuseTexture, texCoord) : vec4(color, 1.0);
+}
+)";
+
+// Mismo cuerpo para los dos caminos: con 3.3 se compila como GLSL 330 y si no como 130. Cada línea son dos vértices
+// iguales; el impar es la punta y se alarga con la longitud pedida. Las de cara van delante de las de vértice.
+static const char* NORMAL_VERTEX_SHADER = R"(
+in vec3 position;
+in vec3 normal;
+uniform mat4 modelViewProjection;
+uniform float normalLength;
+uniform int faceVertexCount;
+out vec3 lineColor;
+void main() {
+    float tip = float(gl_VertexID & 1);
+    lineColor = gl_VertexID < faceVertexCount ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+    gl_Position = modelViewProjection * vec4(position + normal * (normalLength * tip), 1.0);
+}
+)";
+
+static const char* NORMAL_FRAGMENT_SHADER = R"(
+in vec3 lineColor;
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(lineColor, 1.0);
+}
+)";
+
+void Renderer::RenderScene(const std::vector<std::unique_ptr<GameObject>>& gameObjects, const glm::mat4& view, const glm::mat4& projection) {
+    frustum.update(projection * view);
+    viewMatrix = view;
+    projectionMatrix = projection;
+
+    usingCorePath = corePathEnabled && corePath.Init(INSTANCE_MATRIX_LOCATION);
+    legacyMatricesLoaded = false;
+    if (usingCorePath) {
+        corePath.BeginFrame(view, projection);
+    }
+    else {
+        LoadLegacyMatrices();
+    }
+    GameObject::UpdateTransforms();
+
+    stats = RenderStats();
+    stats.objectCount = int(gameObjects.size());
+
+    // ImGui y el resto del frame cambian el estado por su cuenta: se parte de cero y se deja como estaba
+    stateCache.reset();
+    stateCache.resetStats();
+
+    if (!cullingEnabled) {
+        visibleObjects.clear();
+        for (const auto& gameObject : gameObjects) {
+            visibleObjects.push_back(gameObject.get());
+        }
+        DrawObjects(visibleObjects);
+        stats.drawnCount = stats.objectCount;
+    }
+    else {
+        DrawVisibleObjects();
+    }
+
+    stateCache.restoreDefaults();
+    stats.bindsIssued = stateCache.getStats().issued;
+    stats.bindsSaved = stateCache.getStats().saved;
+}
+
+void Renderer::DrawVisibleObjects() {
+    // El BVH descarta subárboles enteros; los objetos que llegan se afinan con su esfera y su caja reales,
+    // porque las cajas del árbol son algo más grandes. Los objetos sin malla no están en el índice:
+    // no tienen nada que dibujar.
+    SpatialIndex& index = SpatialIndex::GetInstance();
+    index.Update();
+
+    visibleObjects.clear();
+    index.QueryFrustum(frustum, visibleObjects);
+    visibleObjects.erase(std::remove_if(visibleObjects.begin(), visibleObjects.end(), [&](GameObject* gameObject) {
+        return !IsVisible(*gameObject);
+    }), visibleObjects.end());
+    DrawObjects(visibleObjects);
+
+    // Solo cuentan como descartados los objetos del índice (con malla) que la cámara dejó fuera
+    stats.drawnCount = int(visibleObjects.size());
+    stats.culledCount = int(index.GetObjectCount()) - stats.drawnCount;
+}
+
+float Renderer::GetDepth(const GameObject& gameObject) const {
+    // Profundidad del centro en espacio de cámara, normalizada con el plano lejano
+    glm::vec4 center = viewMatrix * glm::vec4(gameObject.getWorldSphere().center, 1.0f);
+    return -center.z / FAR_PLANE;
+}
+
+void Renderer::LoadLegacyMatrices() {
+    if (legacyMatricesLoaded) return;
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(&projectionMatrix[0][0]);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(&viewMatrix[0][0]);
+    legacyMatricesLoaded = true;
+}
+
+void Renderer::DrawSingle(GameObject& gameObject, size_t slot) {
+    const std::shared_ptr<const MeshResource>& mesh = gameObject.getModelLoader().getMesh();
+    if (usingCorePath && mesh) {
+        stats.drawCalls += corePath.DrawObject(slot, gameObject, stateCache);
+        return;
+    }
+
+    // Pipeline fijo (o primitivas sin malla subida, que solo sabe dibujar el modo inmediato)
+    LoadLegacyMatrices();
+    stateCache.useProgram(0);
+    gameObject.draw(stateCache);
+    stats.drawCalls += mesh ? int(mesh->getMeshCount()) : 1;
+}
+
+void Renderer::DrawBatch(const InstanceBatch& batch) {
+    if (usingCorePath) {
+        corePath.UseInstancedProgram(stateCache, batch.textureID, batch.color);
+    }
+    else {
+        stateCache.useProgram(instancedShader.getProgram());
+        stateCache.setTexture(batch.textureID);
+        glUniform1i(useTextureLocation, batch.textureID ? GL_TRUE : GL_FALSE);
+        if (!batch.textureID) {
+            glUniform3f(colorLocation, batch.color.r, batch.color.g, batch.color.b);
+        }
+    }
+
+    size_t offset = batch.firstInstance * sizeof(glm::mat4);
+    for (const Mesh& mesh : batch.mesh->getMeshes()) {
+        mesh.drawInstanced(instanceBuffer, offset, batch.instanceCount, INSTANCE_MATRIX_LOCATION);
+        stats.drawCalls++;
+    }
+    stats.instancedBatches++;
+    stats.instancedObjects += int(batch.instanceCount);
+}
+
+void Renderer::DrawObjects(const std::vector<GameObject*>& objects) {
+    bool instancing = instancingEnabled && InitInstancing();
+
+    // Solo se agrupan las mallas ya subidas; las primitivas en modo inmediato van sueltas
+    singleObjects.clear();
+    instanceItems.clear();
+    normalObjects.clear();
+    for (GameObject* gameObject : objects) {
+        ModelLoader& modelLoader = gameObject->getModelLoader();
+        const std::shared_ptr<const MeshResource>& mesh = modelLoader.getMesh();
+        if (mesh && modelLoader.isShowingNormals()) {
+            normalObjects.push_back(gameObject);
+        }
+        if (!instancing || !mesh) {
+            singleObjects.push_back(gameObject);
+            continue;
+        }
+
+        const Material& material = gameObject->getMaterial();
+        unsigned int textureID = material.getTextureID();
+        // Con textura el color no se usa (se dibuja en blanco), así que no separa lotes
+        glm::vec3 color = textureID ? glm::vec3(1.0f) : material.getDefaultColor();
+        instanceItems.push_back({ mesh.get(), textureID, color, GetDepth(*gameObject), gameObject });
+    }
+
+    // Cada tramo con la misma malla y material es un lote, con sus instancias de delante a atrás. Los objetos
+    // sueltos no compensan el cambio de programa.
+    auto key = [](const InstanceItem& item) {
+        return std::make_tuple(item.mesh, item.textureID, item.color.r, item.color.g, item.color.b);
+    };
+    std::sort(instanceItems.begin(), instanceItems.end(), [&](const InstanceItem& a, const InstanceItem& b) {
+        auto keyA = key(a);
+        auto keyB = key(b);
+        return keyA < keyB || (keyA == keyB && a.depth < b.depth);
+    });
+
+    instanceBatches.clear();
+    instanceMatrices.clear();
+    const glm::vec3 modelScale(ModelLoader::MODEL_SCALE);
+    for (size_t first = 0; first < instanceItems.size();) {
+        size_t last = first + 1;
+        while (last < instanceItems.size() && key(instanceItems[last]) == key(instanceItems[first])) last++;
+
+        const InstanceItem& item = instanceItems[first];
+        if (last - first == 1) {
+            singleObjects.push_back(item.gameObject);
+        }
+        else {
+            instanceBatches.push_back({ item.mesh, item.textureID, item.color, item.depth, instanceMatrices.size(), unsigned(last - first) });
+            for (size_t i = first; i < last; i++) {
+                instanceMatrices.push_back(glm::scale(instanceItems[i].gameObject->getTransform(), modelScale));
+            }
+        }
+        first = last;
+    }
+
+    // Todo entra en la cola como clave (programa, textura, malla, profundidad) y se dibuja en ese orden
+    renderQueue.clear();
+    for (size_t i = 0; i < singleObjects.size(); i++) {
+        GameObject& gameObject = *singleObjects[i];
+        ModelLoader& modelLoader = gameObject.getModelLoader();
+        const void* mesh = modelLoader.getMesh() ? static_cast<const void*>(modelLoader.getMesh().get()) : &modelLoader;
+        renderQueue.push(RenderQueue::PROGRAM_SINGLE, renderQueue.getTextureSlot(gameObject.getMaterial().getTextureID()),
+                         renderQueue.getMeshSlot(mesh), GetDepth(gameObject), uint32_t(i));
+    }
+    for (size_t i = 0; i < instanceBatches.size(); i++) {
+        const InstanceBatch& batch = instanceBatches[i];
+        renderQueue.push(RenderQueue::PROGRAM_INSTANCED, renderQueue.getTextureSlot(batch.textureID),
+                         renderQueue.getMeshSlot(batch.mesh), batch.depth, uint32_t(i));
+    }
+    renderQueue.sort();
+
+    if (!instanceMatrices.empty()) {
+        // Todas las matrices del frame van en una sola subida; el buffer se reasigna (huérfano) para no esperar a
+        // que la GPU termine de leer las del frame anterior
+        size_t bytes = instanceMatrices.size() * sizeof(glm::mat4);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        instanceBufferCapacity = std::max(instanceBufferCapacity, bytes);
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(instanceBufferCapacity), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(bytes), instanceMatrices.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    if (usingCorePath) {
+        corePath.UploadObjects(singleObjects);
+    }
+
+    for (const RenderQueue::Command& command : renderQueue.getCommands()) {
+        if (RenderQueue::GetProgram(command.key) == RenderQueue::PROGRAM_INSTANCED) {
+            DrawBatch(instanceBatches[command.index]);
+        }
+        else {
+            DrawSingle(*singleObjects[command.index], command.index);
+        }
+    }
+
+    for (GameObject* gameObject : normalObjects) {
+        DrawNormals(*gameObject);
+    }
+}
+
+void Renderer::DrawNormals(GameObject& gameObject) {
+    if (!InitNormalLines()) return;
+
+    ModelLoader& modelLoader = gameObject.getModelLoader();
+    glm::mat4 model = glm::scale(gameObject.getTransform(), glm::vec3(ModelLoader::MODEL_SCALE));
+    glm::mat4 modelViewProjection = projectionMatrix * viewMatrix * model;
+
+    stateCache.useProgram(normalShader.getProgram());
+    glUniformMatrix4fv(normalMatrixLocation, 1, GL_FALSE, &modelViewProjection[0][0]);
+    // La longitud se pide en el espacio del objeto y las líneas están en el de la malla, antes de MODEL_SCALE
+    glUniform1f(normalLengthLocation, modelLoader.getNormalLength() / ModelLoader::MODEL_SCALE);
+    for (const NormalLines& lines : modelLoader.getMesh()->getNormalLines()) {
+        glUniform1i(faceVertexCountLocation, GLint(lines.getFaceVertexCount()));
+        lines.draw(modelLoader.isShowingFaceNormals(), modelLoader.isShowingVertexNormals());
+        stats.drawCalls++;
+    }
+}
+
+bool Renderer::InitNormalLines() {
+    if (normalLinesState != FeatureState::UNINITIALIZED) return normalLinesState == FeatureState::READY;
+
+    normalLinesState = FeatureState::UNSUPPORTED;
+    std::string version = GLEW_VERSION_3_3 ? "#version 330 core\n" : "#version 130\n";
+    std::string vertexSource = version + NORMAL_VERTEX_SHADER;
+    std::string fragmentSource = version + NORMAL_FRAGMENT_SHADER;
+    if (!normalShader.compile(vertexSource.c_str(), fragmentSource.c_str(),
+                              { { "position", Mesh::POSITION_LOCATION }, { "normal", Mesh::NORMAL_LOCATION } })) {
+        return false;
+    }
+
+    normalMatrixLocation = normalShader.getUniformLocation("modelViewProjection");
+    normalLengthLocation = normalShader.getUniformLocation("normalLength");
+    faceVertexCountLocation = normalShader.getUniformLocation("faceVertexCount");
+    normalLinesState = FeatureState::READY;
+    return true;
+}
+
+bool Renderer::InitInstancing() {
+    if (instancingState != FeatureState::UNINITIALIZED) return instancingState == FeatureState::READY;
+
+    instancingState = FeatureState::UNSUPPORTED;
+    if (!GLEW_ARB_draw_instanced || !GLEW_ARB_instanced_arrays) return false;
+    if (!instancedShader.compile(INSTANCED_VERTEX_SHADER, INSTANCED_FRAGMENT_SHADER, { { "instanceModel", INSTANCE_MATRIX_LOCATION } })) {
+        return false;
+    }
+
+    instancedShader.use();
+    glUniform1i(instancedShader.getUniformLocation("diffuseTexture"), 0);
+    useTextureLocation = instancedShader.getUniformLocation("useTexture");
+    colorLocation = instancedShader.getUniformLocation("color");
+    Shader::unbind();
+
+    glGenBuffers(1, &instanceBuffer);
+    instancingState = FeatureState::READY;
+    return true;
+}
+
+void Renderer::Shutdown() {
+    corePath.Release();
+
+    normalShader.release();
+    normalLinesState = FeatureState::UNINITIALIZED;
+
+    instancedShader.release();
+    if (instanceBuffer) {
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+    instanceBufferCapacity = 0;
+    instancingState = FeatureState::UNINITIALIZED;
+}
+
+bool Renderer::IsVisible(const GameObject& gameObject) const {
+    return frustum.intersects(gameObject.getWorldSphere()) && frustum.intersects(gameObject.getWorldAABB());
+}
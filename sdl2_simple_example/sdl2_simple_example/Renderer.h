@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+#include "GameObject.h"
+#include "Frustum.h"
+#include "Shader.h"
+#include "RenderQueue.h"
+#include "CoreRenderPath.h"
+
+class MeshResource;
+
+// Contadores del último frame dibujado
+struct RenderStats {
+    int objectCount = 0;  // Objetos en la escena
+    int drawnCount = 0;   // Objetos enviados a la GPU
+    int culledCount = 0;  // Descartados por estar fuera de la cámara
+    int drawCalls = 0;         // Llamadas de dibujo de mallas
+    int instancedBatches = 0;  // Grupos dibujados con instancing
+    int instancedObjects = 0;  // Objetos dibujados dentro de esos grupos
+    int bindsIssued = 0;       // Cambios de programa, textura y color enviados a OpenGL
+    int bindsSaved = 0;        // Evitados porque el estado ya era el mismo
+};
+
+// Dibuja la escena: descarta con el frustum de la cámara (a través de SpatialIndex) los objetos que no se
+// ven y dibuja el resto. Los objetos visibles que comparten malla y material se agrupan y se dibujan con
+// instancing: una llamada por malla del recurso con las matrices de modelo en un buffer de instancias.
+// Todo se dibuja a través de una RenderQueue ordenada y los cambios de estado pasan por una RenderStateCache.
+// Con OpenGL 3.3 se dibuja con shaders y uniform buffers (CoreRenderPath); si no, con el pipeline fijo.
+// Las normales activadas se dibujan al final desde las líneas precalculadas de cada malla.
+class Renderer {
+public:
+    static Renderer& GetInstance() {
+        static Renderer instance;
+        return instance;
+    }
+
+    // Sube las matrices de la cámara (al uniform buffer o a OpenGL, según el camino) y dibuja los objetos visibles
+    void RenderScene(const std::vector<std::unique_ptr<GameObject>>& gameObjects, const glm::mat4& view, const glm::mat4& projection);
+
+    const RenderStats& GetStats() const { return stats; }
+    const Frustum& GetFrustum() const { return frustum; }
+
+    bool IsCullingEnabled() const { return cullingEnabled; }
+    void SetCullingEnabled(bool enabled) { cullingEnabled = enabled; }
+
+    // Si la GPU no tiene instancing (o el shader no compila) se dibuja objeto a objeto
+    bool IsInstancingEnabled() const { return instancingEnabled; }
+    void SetInstancingEnabled(bool enabled) { instancingEnabled = enabled; }
+    bool IsInstancingSupported() const { return instancingState != FeatureState::UNSUPPORTED; }
+
+    // Camino con shaders del perfil core; desactivado (o sin soporte) se usa el pipeline fijo
+    bool IsCorePathEnabled() const { return corePathEnabled; }
+    void SetCorePathEnabled(bool enabled) { corePathEnabled = enabled; }
+    bool IsCorePathSupported() const { return corePath.IsSupported(); }
+    bool IsUsingCorePath() const { return usingCorePath; }
+
+    // Libera los programas y buffers de OpenGL. Se llama al salir, mientras el contexto sigue activo: el
+    // singleton se destruye después de la ventana y para entonces ya no hay contexto.
+    void Shutdown();
+
+private:
+    Renderer() = default;
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    // Objetos que pueden ir en un mismo lote: misma malla, misma textura y, sin textura, mismo color
+    struct InstanceItem {
+        const MeshResource* mesh;
+        unsigned int textureID;
+        glm::vec3 color;
+        float depth;
+        GameObject* gameObject;
+    };
+
+    struct InstanceBatch {
+        const MeshResource* mesh;
+        unsigned int textureID;
+        glm::vec3 color;
+        float depth;  // La de la instancia más cercana
+        size_t firstInstance;
+        unsigned int instanceCount;
+    };
+
+    enum class FeatureState { UNINITIALIZED, READY, UNSUPPORTED };
+
+    bool IsVisible(const GameObject& gameObject) const;
+    float GetDepth(const GameObject& gameObject) const;
+    void DrawVisibleObjects();
+    void DrawObjects(const std::vector<GameObject*>& objects);
+    void DrawSingle(GameObject& gameObject, size_t slot);
+    void DrawBatch(const InstanceBatch& batch);
+    bool InitInstancing();
+    bool InitNormalLines();
+    void DrawNormals(GameObject& gameObject);
+    // Solo para el pipeline fijo y las primitivas en modo inmediato; se cargan la primera vez que hacen falta
+    void LoadLegacyMatrices();
+
+    Frustum frustum;
+    RenderStats stats;
+    std::vector<GameObject*> visibleObjects;  // Se reutiliza entre frames para no reservar memoria
+    bool cullingEnabled = true;
+    glm::mat4 viewMatrix = glm::mat4(1.0f);
+    glm::mat4 projectionMatrix = glm::mat4(1.0f);
+    bool legacyMatricesLoaded = false;
+
+    CoreRenderPath corePath;
+    bool corePathEnabled = true;
+    bool usingCorePath = false;  // Camino del frame actual
+
+    RenderQueue renderQueue;
+    RenderStateCache stateCache;
+    std::vector<GameObject*> singleObjects;  // Objetos que se dibujan sin instancing este frame
+    std::vector<GameObject*> normalObjects;  // Objetos que muestran sus normales este frame
+
+    // Normales
+    FeatureState normalLinesState = FeatureState::UNINITIALIZED;
+    Shader normalShader;
+    int normalMatrixLocation = -1;
+    int normalLengthLocation = -1;
+    int faceVertexCountLocation = -1;
+
+    // Instancing
+    bool instancingEnabled = true;
+    FeatureState instancingState = FeatureState::UNINITIALIZED;
+    Shader instancedShader;
+    int useTextureLocation = -1;
+    int colorLocation = -1;
+    unsigned int instanceBuffer = 0;
+    size_t instanceBufferCapacity = 0;
+    std::vector<InstanceItem> instanceItems;
+    std::vector<InstanceBatch> instanceBatches;
+    std::vector<glm::mat4> instanceMatrices;
+};
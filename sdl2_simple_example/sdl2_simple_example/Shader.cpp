@@ -0,0 +1,88 @@
+#include <GL/glew.h>
+#include "Shader.h"
+#include "Logger.h"
+
+static GLuint CompileStage(GLenum stage, const char* source) {
+    GLuint shader = glCreateShader(stage);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024] = {};
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        LOG_FORMAT(WARNING, "%s SHADER ERROR: %s", stage == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+Shader::~Shader() {
+    release();
+}
+
+bool Shader::compile(const char* vertexSource, const char* fragmentSource,
+                     const std::vector<std::pair<const char*, unsigned int>>& attributes) {
+    release();
+
+    GLuint vertex = CompileStage(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragment = CompileStage(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertex || !fragment) {
+        if (vertex) glDeleteShader(vertex);
+        if (fragment) glDeleteShader(fragment);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    for (const auto& attribute : attributes) {
+        glBindAttribLocation(program, attribute.second, attribute.first);
+    }
+    glLinkProgram(program);
+
+    // Una vez enlazado el programa ya no necesita los objetos de cada etapa
+    glDetachShader(program, vertex);
+    glDetachShader(program, fragment);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024] = {};
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        LOG_FORMAT(WARNING, "SHADER LINK ERROR: %s", log);
+        release();
+        return false;
+    }
+    return true;
+}
+
+void Shader::release() {
+    if (program) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+}
+
+void Shader::use() const {
+    glUseProgram(program);
+}
+
+void Shader::unbind() {
+    glUseProgram(0);
+}
+
+int Shader::getUniformLocation(const char* name) const {
+    return glGetUniformLocation(program, name);
+}
+
+void Shader::bindUniformBlock(const char* name, unsigned int binding) const {
+    GLuint index = glGetUniformBlockIndex(program, name);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, binding);
+    }
+}
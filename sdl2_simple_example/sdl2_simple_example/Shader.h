@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+
+// Programa GLSL (vértice + fragmento). Los errores de compilación y enlazado se envían a la consola.
+class Shader {
+public:
+    Shader() = default;
+    ~Shader();
+
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    // attributes fija la posición de los atributos genéricos antes de enlazar (nombre, location)
+    bool compile(const char* vertexSource, const char* fragmentSource,
+                 const std::vector<std::pair<const char*, unsigned int>>& attributes = {});
+    void release();
+
+    void use() const;
+    static void unbind();
+
+    bool isValid() const { return program != 0; }
+    unsigned int getProgram() const { return program; }
+    int getUniformLocation(const char* name) const;
+    // Asocia el bloque uniforme name al punto de enlace binding (si el programa no lo usa no hace nada)
+    void bindUniformBlock(const char* name, unsigned int binding) const;
+
+private:
+    unsigned int program = 0;
+};
@@ -0,0 +1,91 @@
+#include "SpatialIndex.h"
+#include "GameObject.h"
+#include <algorithm>
+
+void SpatialIndex::MarkMoved(GameObject* gameObject) {
+    if (gameObject->indexMovedSlot != -1) return;
+    gameObject->indexMovedSlot = int(moved.size());
+    moved.push_back(gameObject);
+}
+
+void SpatialIndex::Remove(GameObject* gameObject) {
+    // El último de la lista ocupa el hueco: quitar es O(1) y el orden de los movidos no importa
+    int slot = gameObject->indexMovedSlot;
+    if (slot != -1) {
+        GameObject* last = moved.back();
+        moved[slot] = last;
+        last->indexMovedSlot = slot;
+        moved.pop_back();
+        gameObject->indexMovedSlot = -1;
+    }
+    if (gameObject->indexProxy != DynamicBVH::NULL_NODE) {
+        tree.DestroyProxy(gameObject->indexProxy);
+        gameObject->indexProxy = DynamicBVH::NULL_NODE;
+    }
+}
+
+void SpatialIndex::Update() {
+    for (GameObject* gameObject : moved) {
+        gameObject->indexMovedSlot = -1;
+
+        // Sin malla no hay nada que dibujar ni que seleccionar: el objeto sale del árbol
+        const AABB& box = gameObject->getWorldAABB();
+        if (!box.isValid()) {
+            if (gameObject->indexProxy != DynamicBVH::NULL_NODE) {
+                tree.DestroyProxy(gameObject->indexProxy);
+                gameObject->indexProxy = DynamicBVH::NULL_NODE;
+            }
+            continue;
+        }
+
+        if (gameObject->indexProxy == DynamicBVH::NULL_NODE) {
+            gameObject->indexProxy = tree.CreateProxy(box, gameObject);
+        }
+        else {
+            tree.MoveProxy(gameObject->indexProxy, box);
+        }
+    }
+    moved.clear();
+}
+
+void SpatialIndex::QueryFrustum(const Frustum& frustum, std::vector<GameObject*>& out) const {
+    tree.QueryFrustum(frustum, [&](int proxy) {
+        out.push_back(GetObject(proxy));
+    });
+}
+
+void SpatialIndex::QueryBox(const AABB& box, std::vector<GameObject*>& out) const {
+    tree.QueryAABB(box, [&](int proxy) {
+        out.push_back(GetObject(proxy));
+    });
+}
+
+void SpatialIndex::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                            const std::function<float(GameObject* gameObject, float maxDistance)>& callback) const {
+    tree.QueryRay(origin, direction, maxDistance, [&](int proxy, float currentMax) {
+        return callback(GetObject(proxy), currentMax);
+    });
+}
+
+GameObject* SpatialIndex::Raycast(const Ray& ray, float maxDistance, float* hitDistance) const {
+    // El árbol descarta por caja gorda; la malla de cada candidato decide con sus triángulos y cada impacto
+    // recorta la distancia máxima para el resto del recorrido
+    GameObject* closest = nullptr;
+    float closestDistance = maxDistance;
+    QueryRay(ray.origin, ray.direction, maxDistance, [&](GameObject* gameObject, float currentMax) {
+        if (!gameObject->raycast(ray, currentMax, closestDistance)) return currentMax;
+        closest = gameObject;
+        return closestDistance;
+    });
+
+    if (closest && hitDistance) *hitDistance = closestDistance;
+    return closest;
+}
+
+GameObject* SpatialIndex::FindNearest(const glm::vec3& point, float maxDistance) const {
+    int proxy = tree.QueryNearest(point, maxDistance, [&](int candidate) {
+        const AABB& box = GetObject(candidate)->getWorldAABB();
+        return glm::length(point - glm::clamp(point, box.min, box.max));
+    });
+    return proxy == DynamicBVH::NULL_NODE ? nullptr : GetObject(proxy);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <cfloat>
+#include <glm/glm.hpp>
+#include "DynamicBVH.h"
+
+class GameObject;
+
+// Índice espacial de la escena: un DynamicBVH con los GameObjects que tienen malla. Los objetos avisan
+// cuando cambia su transformación o su malla y el árbol solo se toca para esos, en Update.
+class SpatialIndex {
+public:
+    static SpatialIndex& GetInstance() {
+        static SpatialIndex instance;
+        return instance;
+    }
+
+    // Lo llama GameObject cuando sus volúmenes de mundo dejan de ser válidos
+    void MarkMoved(GameObject* gameObject);
+    // Lo llama GameObject al destruirse
+    void Remove(GameObject* gameObject);
+
+    // Reinserta los objetos movidos desde el último Update; se llama antes de cualquier consulta del frame
+    void Update();
+
+    void QueryFrustum(const Frustum& frustum, std::vector<GameObject*>& out) const;
+    void QueryBox(const AABB& box, std::vector<GameObject*>& out) const;
+
+    // Objetos cuya caja gorda cruza el rayo. En cada nodo se baja antes por el hijo donde entra primero el
+    // rayo, así que los candidatos llegan aproximadamente de cerca a lejos (no es un orden estricto entre ramas).
+    // El callback devuelve su distancia de impacto para descartar lo que quede detrás, o la que recibe si no hay impacto
+    void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  const std::function<float(GameObject* gameObject, float maxDistance)>& callback) const;
+
+    // Objeto cuya caja de mundo queda más cerca del punto; nullptr si no hay ninguno a menos de maxDistance
+    GameObject* FindNearest(const glm::vec3& point, float maxDistance = FLT_MAX) const;
+
+    // Objeto cuyo triángulo más cercano corta el rayo (selección en el viewport); nullptr si no toca ninguno
+    GameObject* Raycast(const Ray& ray, float maxDistance = FLT_MAX, float* hitDistance = nullptr) const;
+
+    size_t GetObjectCount() const { return tree.GetProxyCount(); }
+    int GetTreeHeight() const { return tree.GetHeight(); }
+
+private:
+    SpatialIndex() = default;
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    GameObject* GetObject(int proxy) const { return static_cast<GameObject*>(tree.GetUserData(proxy)); }
+
+    DynamicBVH tree;
+    std::vector<GameObject*> moved;
+};
@@ -0,0 +1,329 @@
+#include "TextureCooker.h"
+#include "AssetPath.h"
+#include "Profiler.h"
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static const char* COOKED_TEXTURE_DIRECTORY = "Library/Textures";
+
+// Cabecera DDS (solo los campos que se usan; el resto se escribe a cero)
+static const uint32_t DDS_MAGIC = 0x20534444;  // "DDS "
+static const uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000;
+static const uint32_t DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+static const uint32_t DDPF_FOURCC = 0x4;
+static const uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+static const uint32_t FOURCC_DXT1 = 0x31545844;  // "DXT1"
+static const uint32_t FOURCC_DXT5 = 0x35545844;  // "DXT5"
+
+struct DDSPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask, gBitMask, bBitMask, aBitMask;
+};
+
+struct DDSHeader {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    DDSPixelFormat pixelFormat;
+    uint32_t caps, caps2, caps3, caps4;
+    uint32_t reserved2;
+};
+
+static_assert(sizeof(DDSHeader) == 128, "La cabecera DDS ocupa 4 + 124 bytes");
+
+bool CookedTextureFile::open(const std::string& path) {
+    levels.clear();
+    if (!file.open(path)) return false;
+
+    const unsigned char* data = file.getData();
+    size_t size = file.getSize();
+
+    if (size < sizeof(DDSHeader)) return false;
+    const DDSHeader* header = reinterpret_cast<const DDSHeader*>(data);
+    if (header->magic != DDS_MAGIC || header->size != 124 || !(header->pixelFormat.flags & DDPF_FOURCC)) return false;
+
+    if (header->pixelFormat.fourCC == FOURCC_DXT1) compression = TextureCompression::BC1;
+    else if (header->pixelFormat.fourCC == FOURCC_DXT5) compression = TextureCompression::BC3;
+    else return false;
+
+    int width = static_cast<int>(header->width);
+    int height = static_cast<int>(header->height);
+    uint32_t levelCount = (header->flags & DDSD_MIPMAPCOUNT) ? std::max<uint32_t>(header->mipMapCount, 1) : 1;
+    if (width <= 0 || height <= 0 || levelCount > 32) return false;
+
+    size_t offset = sizeof(DDSHeader);
+    for (uint32_t i = 0; i < levelCount; i++) {
+        size_t levelSize = TextureCooker::getLevelSize(compression, width, height);
+        if (levelSize > size - offset) {
+            levels.clear();
+            return false;
+        }
+        levels.push_back({ width, height, data + offset, levelSize });
+        offset += levelSize;
+
+        if (width == 1 && height == 1) break;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+
+    return true;
+}
+
+std::string TextureCooker::getCookedPath(const std::string& assetPath) {
+    return GetCookedAssetPath(assetPath, COOKED_TEXTURE_DIRECTORY, ".dds");
+}
+
+bool TextureCooker::isUpToDate(const std::string& assetPath, const std::string& cookedPath) {
+    return IsCookedAssetUpToDate(assetPath, cookedPath);
+}
+
+size_t TextureCooker::getLevelSize(TextureCompression compression, int width, int height) {
+    size_t blockBytes = compression == TextureCompression::BC1 ? 8 : 16;
+    return size_t((width + 3) / 4) * size_t((height + 3) / 4) * blockBytes;
+}
+
+// Siguiente nivel de mip con un filtro de caja 2x2 (en los bordes impares se repite la última fila/columna)
+static std::vector<unsigned char> Downsample(const std::vector<unsigned char>& source, int width, int height) {
+    int nextWidth = std::max(1, width / 2);
+    int nextHeight = std::max(1, height / 2);
+    std::vector<unsigned char> next(size_t(nextWidth) * nextHeight * 4);
+
+    for (int y = 0; y < nextHeight; y++) {
+        int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < nextWidth; x++) {
+            int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+            const unsigned char* p00 = &source[(size_t(y0) * width + x0) * 4];
+            const unsigned char* p01 = &source[(size_t(y0) * width + x1) * 4];
+            const unsigned char* p10 = &source[(size_t(y1) * width + x0) * 4];
+            const unsigned char* p11 = &source[(size_t(y1) * width + x1) * 4];
+            unsigned char* out = &next[(size_t(y) * nextWidth + x) * 4];
+            for (int c = 0; c < 4; c++) {
+                out[c] = static_cast<unsigned char>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+            }
+        }
+    }
+    return next;
+}
+
+static uint16_t PackRGB565(const int color[3]) {
+    int r = (color[0] * 31 + 127) / 255;
+    int g = (color[1] * 63 + 127) / 255;
+    int b = (color[2] * 31 + 127) / 255;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// Bloque de color BC1: extremos en las esquinas de la caja de color del bloque, encogida 1/16 hacia dentro
+// para reducir el error medio, y cada píxel asignado al más cercano de los cuatro colores de la paleta
+static void EncodeColorBlock(const unsigned char block[64], unsigned char out[8]) {
+    int minColor[3] = { 255, 255, 255 };
+    int maxColor[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            minColor[c] = std::min(minColor[c], int(block[i * 4 + c]));
+            maxColor[c] = std::max(maxColor[c], int(block[i * 4 + c]));
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        int inset = (maxColor[c] - minColor[c]) >> 4;
+        minColor[c] += inset;
+        maxColor[c] -= inset;
+    }
+
+    // Cada canal de maxColor es >= que el de minColor, así que color0 >= color1 y se usa el modo de 4 colores
+    uint16_t color0 = PackRGB565(maxColor);
+    uint16_t color1 = PackRGB565(minColor);
+
+    int palette[4][3];
+    UnpackRGB565(color0, palette[0]);
+    UnpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDistance = 0x7fffffff;
+            for (int p = 0; p < 4; p++) {
+                int distance = 0;
+                for (int c = 0; c < 3; c++) {
+                    int d = int(block[i * 4 + c]) - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= uint32_t(best) << (i * 2);
+        }
+    }
+
+    out[0] = color0 & 0xff;
+    out[1] = color0 >> 8;
+    out[2] = color1 & 0xff;
+    out[3] = color1 >> 8;
+    for (int k = 0; k < 4; k++) {
+        out[4 + k] = (indices >> (k * 8)) & 0xff;
+    }
+}
+
+// Bloque de alfa BC3: extremos mínimo y máximo con 6 valores interpolados e índices de 3 bits
+static void EncodeAlphaBlock(const unsigned char block[64], unsigned char out[8]) {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; i++) {
+        minAlpha = std::min(minAlpha, int(block[i * 4 + 3]));
+        maxAlpha = std::max(maxAlpha, int(block[i * 4 + 3]));
+    }
+
+    int palette[8] = { maxAlpha, minAlpha };
+    for (int p = 2; p < 8; p++) {
+        palette[p] = ((8 - p) * maxAlpha + (p - 1) * minAlpha) / 7;
+    }
+
+    uint64_t indices = 0;
+    if (maxAlpha != minAlpha) {
+        for (int i = 0; i < 16; i++) {
+            int alpha = block[i * 4 + 3];
+            int best = 0, bestDistance = 256;
+            for (int p = 0; p < 8; p++) {
+                int distance = std::abs(alpha - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= uint64_t(best) << (i * 3);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(maxAlpha);
+    out[1] = static_cast<unsigned char>(minAlpha);
+    for (int k = 0; k < 6; k++) {
+        out[2 + k] = (indices >> (k * 8)) & 0xff;
+    }
+}
+
+static void EncodeLevel(const TextureLevelData& level, TextureCompression compression, std::vector<unsigned char>& out) {
+    const std::vector<unsigned char>& pixels = level.data;
+    int width = level.width, height = level.height;
+    size_t blockBytes = compression == TextureCompression::BC1 ? 8 : 16;
+    out.resize(TextureCooker::getLevelSize(compression, width, height));
+
+    unsigned char block[64];
+    unsigned char* write = out.data();
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            // Los bloques que se salen de un nivel pequeño repiten el último píxel válido
+            for (int y = 0; y < 4; y++) {
+                int sy = std::min(by + y, height - 1);
+                for (int x = 0; x < 4; x++) {
+                    int sx = std::min(bx + x, width - 1);
+                    std::memcpy(&block[(y * 4 + x) * 4], &pixels[(size_t(sy) * width + sx) * 4], 4);
+                }
+            }
+
+            if (compression == TextureCompression::BC3) {
+                EncodeAlphaBlock(block, write);
+                EncodeColorBlock(block, write + 8);
+            }
+            else {
+                EncodeColorBlock(block, write);
+            }
+            write += blockBytes;
+        }
+    }
+}
+
+void TextureCooker::buildMipChain(const unsigned char* rgba, int width, int height, std::vector<TextureLevelData>& levels) {
+    levels.clear();
+    levels.push_back({ width, height, std::vector<unsigned char>(rgba, rgba + size_t(width) * height * 4) });
+
+    while (width > 1 || height > 1) {
+        std::vector<unsigned char> next = Downsample(levels.back().data, width, height);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        levels.push_back({ width, height, std::move(next) });
+    }
+}
+
+bool TextureCooker::cook(const std::string& cookedPath, const unsigned char* rgba, int width, int height) {
+    PROFILE_SCOPE("Cook Texture");
+    if (!rgba || width <= 0 || height <= 0) return false;
+
+    bool hasAlpha = false;
+    for (size_t i = 3; i < size_t(width) * height * 4 && !hasAlpha; i += 4) {
+        hasAlpha = rgba[i] != 255;
+    }
+    TextureCompression compression = hasAlpha ? TextureCompression::BC3 : TextureCompression::BC1;
+
+    std::vector<TextureLevelData> levels;
+    buildMipChain(rgba, width, height, levels);
+
+    std::error_code error;
+    fs::create_directories(fs::path(cookedPath).parent_path(), error);
+
+    // Igual que con las mallas: temporal propio de cada hilo y renombrado al terminar
+    std::string tempPath = cookedPath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        DDSHeader header = {};
+        header.magic = DDS_MAGIC;
+        header.size = 124;
+        header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+        header.height = static_cast<uint32_t>(height);
+        header.width = static_cast<uint32_t>(width);
+        header.pitchOrLinearSize = static_cast<uint32_t>(getLevelSize(compression, width, height));
+        header.mipMapCount = static_cast<uint32_t>(levels.size());
+        header.pixelFormat.size = sizeof(DDSPixelFormat);
+        header.pixelFormat.flags = DDPF_FOURCC;
+        header.pixelFormat.fourCC = compression == TextureCompression::BC3 ? FOURCC_DXT5 : FOURCC_DXT1;
+        header.caps = DDSCAPS_TEXTURE | DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::vector<unsigned char> encoded;
+        for (const TextureLevelData& level : levels) {
+            EncodeLevel(level, compression, encoded);
+            out.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+        }
+
+        if (!out) {
+            out.close();
+            fs::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, cookedPath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
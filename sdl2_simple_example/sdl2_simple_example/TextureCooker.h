@@ -0,0 +1,67 @@
+#ifndef TEXTURECOOKER_H
+#define TEXTURECOOKER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "MappedFile.h"
+
+// Texturas cocinadas (.dds): cabecera DDS clásica con FourCC DXT1 (BC1) o DXT5 (BC3) y la cadena de mips
+// completa a continuación. Las filas se guardan en el orden que espera OpenGL (de abajo a arriba), el mismo
+// con el que DevIL entrega las imágenes; es una caché interna del motor, no un formato de intercambio.
+enum class TextureCompression {
+    BC1,  // RGB opaco, 8 bytes por bloque de 4x4
+    BC3   // RGBA, 16 bytes por bloque de 4x4
+};
+
+// Vista de un nivel de mip dentro del fichero mapeado; válida mientras el fichero siga abierto
+struct CookedTextureLevel {
+    int width;
+    int height;
+    const unsigned char* data;
+    size_t size;
+};
+
+// Un nivel de mip en memoria: RGBA8 sin comprimir o bloques BC1/BC3, según de dónde venga
+struct TextureLevelData {
+    int width;
+    int height;
+    std::vector<unsigned char> data;
+};
+
+class CookedTextureFile {
+public:
+    // Mapea el fichero y valida la cabecera y el tamaño de cada nivel
+    bool open(const std::string& path);
+
+    TextureCompression getCompression() const { return compression; }
+    int getWidth() const { return levels.empty() ? 0 : levels[0].width; }
+    int getHeight() const { return levels.empty() ? 0 : levels[0].height; }
+    size_t getLevelCount() const { return levels.size(); }
+    const CookedTextureLevel& getLevel(size_t index) const { return levels[index]; }
+
+private:
+    MappedFile file;
+    TextureCompression compression = TextureCompression::BC1;
+    std::vector<CookedTextureLevel> levels;
+};
+
+class TextureCooker {
+public:
+    // Ruta del fichero cocinado correspondiente a un asset (Library/Textures/<nombre>_<hash>.dds)
+    static std::string getCookedPath(const std::string& assetPath);
+
+    // El fichero cocinado existe y es más reciente que el asset original
+    static bool isUpToDate(const std::string& assetPath, const std::string& cookedPath);
+
+    // Cadena de mips RGBA8 completa (hasta 1x1) con un filtro de caja 2x2; el nivel 0 es la propia imagen
+    static void buildMipChain(const unsigned char* rgba, int width, int height, std::vector<TextureLevelData>& levels);
+
+    // Genera los mips de una imagen RGBA8 y los guarda en BC1 si es opaca o en BC3 si tiene transparencias
+    static bool cook(const std::string& cookedPath, const unsigned char* rgba, int width, int height);
+
+    // Bytes que ocupa un nivel comprimido (los bloques cubren siempre 4x4, aunque el nivel sea menor)
+    static size_t getLevelSize(TextureCompression compression, int width, int height);
+};
+
+#endif // TEXTURECOOKER_H
@@ -0,0 +1,223 @@
+#include <GL/glew.h>
+#include "TextureManager.h"
+#include "Material.h"
+#include "AssetLoader.h"
+#include "AssetPath.h"
+#include "Profiler.h"
+#include <filesystem>
+#include <cstring>
+#include <IL/il.h>
+#include <IL/ilu.h>
+#include <IL/ilut.h>
+
+// DevIL guarda la imagen activa en estado global: los hilos de carga decodifican de uno en uno
+static std::mutex devilMutex;
+
+Texture::Texture(unsigned int id, int width, int height, const std::string& path)
+    : id(id), width(width), height(height), levelCount(1), uploadedLevels(1), failed(false), path(path) {}
+
+Texture::Texture(const std::string& path)
+    : id(0), width(0), height(0), levelCount(0), uploadedLevels(0), failed(false), path(path) {}
+
+Texture::~Texture() {
+    release();
+}
+
+void Texture::release() {
+    if (id) {
+        glDeleteTextures(1, &id);
+        id = 0;
+    }
+}
+
+// Decodifica la imagen con DevIL a RGBA8, con la primera fila abajo como espera OpenGL
+static bool DecodeImage(const std::string& path, std::vector<unsigned char>& pixels, int& width, int& height) {
+    PROFILE_SCOPE("Decode Image");
+    std::lock_guard<std::mutex> lock(devilMutex);
+
+    ilEnable(IL_ORIGIN_SET);
+    ilOriginFunc(IL_ORIGIN_LOWER_LEFT);
+
+    ILconst_string apath = reinterpret_cast<const ILconst_string>(path.c_str());
+    ILuint imageID;
+    ilGenImages(1, &imageID);
+    ilBindImage(imageID);
+
+    if (!ilLoadImage(apath) || !ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE)) {
+        ilDeleteImages(1, &imageID);
+        return false;
+    }
+
+    width = ilGetInteger(IL_IMAGE_WIDTH);
+    height = ilGetInteger(IL_IMAGE_HEIGHT);
+    const unsigned char* data = ilGetData();
+    pixels.assign(data, data + size_t(width) * height * 4);
+
+    ilDeleteImages(1, &imageID);
+    return true;
+}
+
+bool TextureStream::read(const std::string& path) {
+    PROFILE_SCOPE("Read Texture");
+    levels.clear();
+    uploadedLevels = 0;
+
+    std::vector<unsigned char> pixels;
+    int width = 0, height = 0;
+
+    // Con S3TC se usa el fichero cocinado (BC1/BC3 con mips) y la imagen original solo se decodifica para cocinarla
+    if (GLEW_EXT_texture_compression_s3tc) {
+        std::string cookedPath = TextureCooker::getCookedPath(path);
+        if (!TextureCooker::isUpToDate(path, cookedPath)) {
+            if (!DecodeImage(path, pixels, width, height)) return false;
+            TextureCooker::cook(cookedPath, pixels.data(), width, height);
+        }
+
+        // Se copia fuera del mapeo aquí para que el hilo principal no tenga fallos de página al subir
+        CookedTextureFile file;
+        if (file.open(cookedPath)) {
+            compressed = true;
+            compression = file.getCompression();
+            for (size_t i = 0; i < file.getLevelCount(); i++) {
+                const CookedTextureLevel& level = file.getLevel(i);
+                levels.push_back({ level.width, level.height, std::vector<unsigned char>(level.data, level.data + level.size) });
+            }
+            levelCount = levels.size();
+            return true;
+        }
+    }
+
+    // Sin compresión disponible (o si no se pudo cocinar) se sube en RGBA8, pero igualmente con mips
+    if (pixels.empty() && !DecodeImage(path, pixels, width, height)) return false;
+
+    compressed = false;
+    TextureCooker::buildMipChain(pixels.data(), width, height, levels);
+    levelCount = levels.size();
+    return true;
+}
+
+bool TextureStream::uploadNext(Texture& texture) {
+    if (uploadedLevels >= levelCount) return false;
+    PROFILE_SCOPE("Upload Texture Level");
+
+    if (!texture.id) {
+        glGenTextures(1, &texture.id);
+        texture.width = levels[0].width;
+        texture.height = levels[0].height;
+        texture.levelCount = int(levelCount);
+    }
+    if (!pixelBuffer) {
+        glGenBuffers(1, &pixelBuffer);
+    }
+
+    size_t levelIndex = levelCount - 1 - uploadedLevels;
+    const TextureLevelData& level = levels[levelIndex];
+
+    // Se copia al PBO pidiendo almacenamiento nuevo (el anterior puede seguir en uso por el driver), así la
+    // transferencia a la textura no espera a que la GPU termine con la subida del frame anterior
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(level.data.size()), nullptr, GL_STREAM_DRAW);
+    const void* source = nullptr;
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(level.data.size()), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        std::memcpy(mapped, level.data.data(), level.data.size());
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    else {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        source = level.data.data();
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    if (compressed) {
+        GLenum format = compression == TextureCompression::BC3 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        glCompressedTexImage2D(GL_TEXTURE_2D, GLint(levelIndex), format, level.width, level.height, 0, GLsizei(level.data.size()), source);
+    }
+    else {
+        glTexImage2D(GL_TEXTURE_2D, GLint(levelIndex), GL_RGBA, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, source);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    // Solo se muestrean los niveles que ya están en la GPU; la textura se va afinando según llegan los grandes
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, GLint(levelIndex));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, GLint(levelCount - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    uploadedLevels++;
+    texture.uploadedLevels = int(uploadedLevels);
+
+    if (uploadedLevels < levelCount) return true;
+    release();
+    return false;
+}
+
+void TextureStream::release() {
+    if (pixelBuffer) {
+        glDeleteBuffers(1, &pixelBuffer);
+        pixelBuffer = 0;
+    }
+    levels.clear();
+    levels.shrink_to_fit();
+}
+
+TextureManager::TextureManager() {
+    ilInit();
+    iluInit();
+    ilutRenderer(ILUT_OPENGL);
+}
+
+std::shared_ptr<Texture> TextureManager::Load(const std::string& path) {
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) return nullptr;
+
+    std::string key = GetAssetKey(path);
+    std::shared_ptr<Texture> texture;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::weak_ptr<Texture>& entry = textures[key];
+        texture = entry.lock();
+        if (texture && !texture->hasFailed()) {
+            return texture;
+        }
+
+        texture = std::make_shared<Texture>(path);
+        entry = texture;
+    }
+
+    // Lectura en un hilo de carga y subida progresiva en AssetLoader::Update; mientras, se dibuja la de cuadros
+    AssetLoader::GetInstance().QueueTexture(texture);
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureManager::GetCheckerTexture() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!checkerTexture) {
+        const int size = 256;
+        checkerTexture = std::make_shared<Texture>(Material::generateCheckeredTexture(size, size), size, size, "");
+    }
+    return checkerTexture;
+}
+
+void TextureManager::Shutdown() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (checkerTexture) {
+        checkerTexture->release();
+        checkerTexture.reset();
+    }
+    for (auto& entry : textures) {
+        if (std::shared_ptr<Texture> texture = entry.second.lock()) {
+            texture->release();
+        }
+    }
+    textures.clear();
+}
+
+size_t TextureManager::GetTextureCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.expired()) it = textures.erase(it);
+        else ++it;
+    }
+    return textures.size();
+}
@@ -0,0 +1,115 @@
+#ifndef TEXTUREMANAGER_H
+#define TEXTUREMANAGER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "TextureCooker.h"
+
+// Textura de OpenGL compartida; se borra de la GPU cuando desaparece el último material que la usa
+class Texture {
+public:
+    // Textura ya subida entera por quien la crea
+    Texture(unsigned int id, int width, int height, const std::string& path);
+
+    // Textura que llegará en segundo plano; no tiene ID ni tamaño hasta que se sube su primer nivel
+    explicit Texture(const std::string& path);
+
+    ~Texture();
+
+    // Borra la textura de la GPU aunque aún haya materiales que la compartan (solo al cerrar el contexto)
+    void release();
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
+    unsigned int getID() const { return id; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const std::string& getPath() const { return path; }
+
+    // Hay al menos un mip subido y ya se puede muestrear (los más pequeños llegan primero)
+    bool isReady() const { return uploadedLevels > 0; }
+    // Están subidos todos los niveles
+    bool isResident() const { return levelCount > 0 && uploadedLevels == levelCount; }
+
+    bool hasFailed() const { return failed; }
+    void setFailed() { failed = true; }
+
+private:
+    friend class TextureStream;
+
+    unsigned int id;
+    int width;
+    int height;
+    int levelCount;
+    int uploadedLevels;
+    bool failed;
+    std::string path;
+};
+
+// Datos de una textura leídos en un hilo de carga y subidos después, nivel a nivel y del mip más pequeño
+// al más grande, a través de un pixel buffer object
+class TextureStream {
+public:
+    TextureStream() = default;
+    TextureStream(const TextureStream&) = delete;
+    TextureStream& operator=(const TextureStream&) = delete;
+
+    // Hilo de carga: lee el fichero cocinado (cocinándolo antes si hace falta) o, sin S3TC, decodifica la
+    // imagen y genera sus mips. Sin llamadas a OpenGL.
+    bool read(const std::string& path);
+
+    // Hilo principal: sube el siguiente nivel; devuelve false cuando ya no quedan
+    bool uploadNext(Texture& texture);
+
+    // Hilo principal: libera el PBO y los datos en CPU (al terminar o al cancelar)
+    void release();
+
+    bool isUploaded() const { return uploadedLevels == levelCount; }
+    size_t getLevelCount() const { return levelCount; }
+    size_t getUploadedLevelCount() const { return uploadedLevels; }
+
+private:
+    std::vector<TextureLevelData> levels;
+    bool compressed = false;
+    TextureCompression compression = TextureCompression::BC1;
+    size_t levelCount = 0;
+    size_t uploadedLevels = 0;
+    unsigned int pixelBuffer = 0;
+};
+
+// Caché de texturas por ruta: cada imagen se lee y se sube una sola vez mientras alguien la use
+class TextureManager {
+public:
+    static TextureManager& GetInstance() {
+        static TextureManager instance;
+        return instance;
+    }
+
+    // Devuelve la textura compartida de esa ruta. Si no estaba cargada se encola en AssetLoader y se devuelve
+    // enseguida, todavía sin subir; nullptr si el fichero no existe.
+    std::shared_ptr<Texture> Load(const std::string& path);
+
+    // Textura de cuadros para comprobar las UVs y para dibujar mientras llega una textura
+    std::shared_ptr<Texture> GetCheckerTexture();
+
+    size_t GetTextureCount();
+
+    // Borra de la GPU la textura de cuadros y las que sigan vivas. Se llama al salir, con el contexto activo y
+    // después de AssetLoader::Stop, que ya ha liberado los PBO de las texturas a medio subir.
+    void Shutdown();
+
+private:
+    TextureManager();
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    std::unordered_map<std::string, std::weak_ptr<Texture>> textures;
+    std::shared_ptr<Texture> checkerTexture;  // Se mantiene viva: se usa cada frame como relleno
+    std::mutex mutex;
+};
+
+#endif // TEXTUREMANAGER_H
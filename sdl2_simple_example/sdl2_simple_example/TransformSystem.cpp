@@ -0,0 +1,377 @@
+#include "TransformSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <emmintrin.h>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <memory>
+#include <string>
+
+static const float DEGREES_TO_RADIANS = 0.01745329252f;
+
+// Seno y coseno de cuatro ángulos a la vez: se reduce al cuadrante (múltiplos de pi/2) y se evalúan los
+// polinomios de Taylor en [-pi/4, pi/4], intercambiando y cambiando el signo según el cuadrante.
+// Error por debajo de 1e-6, de sobra para matrices de transformación.
+static void SinCos4(__m128 x, __m128& sine, __m128& cosine) {
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.636619772f)));
+    __m128 quadrantF = _mm_cvtepi32_ps(quadrant);
+
+    // pi/2 partido en dos constantes para no perder precisión al restar
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(quadrantF, _mm_set1_ps(1.57079637f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, _mm_set1_ps(-4.37113900e-8f)));
+    __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 sinPoly = _mm_add_ps(_mm_set1_ps(-1.0f / 5040.0f), _mm_mul_ps(r2, _mm_set1_ps(1.0f / 362880.0f)));
+    sinPoly = _mm_add_ps(_mm_set1_ps(1.0f / 120.0f), _mm_mul_ps(r2, sinPoly));
+    sinPoly = _mm_add_ps(_mm_set1_ps(-1.0f / 6.0f), _mm_mul_ps(r2, sinPoly));
+    sinPoly = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), sinPoly));
+
+    __m128 cosPoly = _mm_add_ps(_mm_set1_ps(-1.0f / 720.0f), _mm_mul_ps(r2, _mm_set1_ps(1.0f / 40320.0f)));
+    cosPoly = _mm_add_ps(_mm_set1_ps(1.0f / 24.0f), _mm_mul_ps(r2, cosPoly));
+    cosPoly = _mm_add_ps(_mm_set1_ps(-0.5f), _mm_mul_ps(r2, cosPoly));
+    cosPoly = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, cosPoly));
+
+    // En los cuadrantes impares seno y coseno se intercambian
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    sine = _mm_or_ps(_mm_and_ps(swap, cosPoly), _mm_andnot_ps(swap, sinPoly));
+    cosine = _mm_or_ps(_mm_and_ps(swap, sinPoly), _mm_andnot_ps(swap, cosPoly));
+
+    // Signo: el bit 1 del cuadrante (y del cuadrante + 1 para el coseno) va al bit de signo
+    __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+    __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+    sine = _mm_xor_ps(sine, sineSign);
+    cosine = _mm_xor_ps(cosine, cosineSign);
+}
+
+// Carga un componente de cuatro handles; si son consecutivos, con una sola lectura
+static __m128 Gather4(const std::vector<float>& values, const int* handles, bool contiguous) {
+    if (contiguous) return _mm_loadu_ps(&values[handles[0]]);
+    return _mm_setr_ps(values[handles[0]], values[handles[1]], values[handles[2]], values[handles[3]]);
+}
+
+// out = a * b con las columnas de a combinadas por los elementos de cada columna de b
+static void MultiplyMatrices(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+    const float* pa = &a[0][0];
+    const float* pb = &b[0][0];
+    float* po = &out[0][0];
+    __m128 a0 = _mm_loadu_ps(pa);
+    __m128 a1 = _mm_loadu_ps(pa + 4);
+    __m128 a2 = _mm_loadu_ps(pa + 8);
+    __m128 a3 = _mm_loadu_ps(pa + 12);
+    for (int column = 0; column < 4; column++) {
+        const float* bc = pb + column * 4;
+        __m128 result = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+        result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+        _mm_storeu_ps(po + column * 4, result);
+    }
+}
+
+int TransformSystem::Create(GameObject* owner) {
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    else {
+        handle = int(owners.size());
+        for (std::vector<float>* component : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &scaleX, &scaleY, &scaleZ }) {
+            component->push_back(0.0f);
+        }
+        localMatrices.emplace_back(1.0f);
+        worldMatrices.emplace_back(1.0f);
+        parents.push_back(NULL_HANDLE);
+        firstChildren.push_back(NULL_HANDLE);
+        nextSiblings.push_back(NULL_HANDLE);
+        previousSiblings.push_back(NULL_HANDLE);
+        flags.push_back(0);
+        owners.push_back(nullptr);
+    }
+
+    positionX[handle] = positionY[handle] = positionZ[handle] = 0.0f;
+    rotationX[handle] = rotationY[handle] = rotationZ[handle] = 0.0f;
+    scaleX[handle] = scaleY[handle] = scaleZ[handle] = 1.0f;
+    localMatrices[handle] = glm::mat4(1.0f);
+    worldMatrices[handle] = glm::mat4(1.0f);
+    parents[handle] = firstChildren[handle] = nextSiblings[handle] = previousSiblings[handle] = NULL_HANDLE;
+    flags[handle] = 0;
+    owners[handle] = owner;
+    MarkDirty(handle);
+    return handle;
+}
+
+void TransformSystem::Destroy(int handle) {
+    Unlink(handle);
+    while (firstChildren[handle] != NULL_HANDLE) {
+        SetParent(firstChildren[handle], NULL_HANDLE);
+    }
+
+    // Si sigue en las listas de pendientes, Update lo descarta por el indicador
+    flags[handle] = FREE;
+    owners[handle] = nullptr;
+    freeHandles.push_back(handle);
+}
+
+void TransformSystem::SetPosition(int handle, const glm::vec3& position) {
+    positionX[handle] = position.x;
+    positionY[handle] = position.y;
+    positionZ[handle] = position.z;
+    MarkDirty(handle);
+}
+
+void TransformSystem::SetRotation(int handle, const glm::vec3& rotation) {
+    rotationX[handle] = rotation.x;
+    rotationY[handle] = rotation.y;
+    rotationZ[handle] = rotation.z;
+    MarkDirty(handle);
+}
+
+void TransformSystem::SetScale(int handle, const glm::vec3& scale) {
+    scaleX[handle] = scale.x;
+    scaleY[handle] = scale.y;
+    scaleZ[handle] = scale.z;
+    MarkDirty(handle);
+}
+
+void TransformSystem::Unlink(int handle) {
+    int parent = parents[handle];
+    if (parent == NULL_HANDLE) return;
+
+    int previous = previousSiblings[handle];
+    int next = nextSiblings[handle];
+    if (previous != NULL_HANDLE) nextSiblings[previous] = next;
+    else firstChildren[parent] = next;
+    if (next != NULL_HANDLE) previousSiblings[next] = previous;
+
+    parents[handle] = previousSiblings[handle] = nextSiblings[handle] = NULL_HANDLE;
+}
+
+void TransformSystem::SetParent(int handle, int parentHandle) {
+    if (parents[handle] == parentHandle) return;
+
+    Unlink(handle);
+    if (parentHandle != NULL_HANDLE) {
+        int first = firstChildren[parentHandle];
+        nextSiblings[handle] = first;
+        if (first != NULL_HANDLE) previousSiblings[first] = handle;
+        firstChildren[parentHandle] = handle;
+        parents[handle] = parentHandle;
+    }
+    MarkDirty(handle);
+}
+
+// Se marca el handle y sus ancestros hasta el primero que ya lo estaba; si se llega a la raíz, se encola
+// para que Update baje desde ella. Así cambiar muchos hijos del mismo padre no recorre la rama cada vez.
+void TransformSystem::MarkDirty(int handle) {
+    if (!(flags[handle] & LOCAL_DIRTY)) {
+        flags[handle] |= LOCAL_DIRTY;
+        dirtyLocals.push_back(handle);
+    }
+
+    int node = handle;
+    while (parents[node] != NULL_HANDLE) {
+        int parent = parents[node];
+        if (flags[parent] & CHILD_DIRTY) return;
+        flags[parent] |= CHILD_DIRTY;
+        node = parent;
+    }
+    if (!(flags[node] & ROOT_QUEUED)) {
+        flags[node] |= ROOT_QUEUED;
+        dirtyRoots.push_back(node);
+    }
+}
+
+// T * Rx * Ry * Rz * S de cuatro objetos a la vez: cada registro lleva el mismo elemento de las cuatro
+// matrices y al final se trasponen para escribir cada columna en su matriz
+void TransformSystem::ComputeLocalMatrices(const int* handles, size_t count) {
+    const __m128 toRadians = _mm_set1_ps(DEGREES_TO_RADIANS);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int* h = handles + i;
+        bool contiguous = h[1] == h[0] + 1 && h[2] == h[0] + 2 && h[3] == h[0] + 3;
+
+        __m128 sa, ca, sb, cb, sc, cc;
+        SinCos4(_mm_mul_ps(Gather4(rotationX, h, contiguous), toRadians), sa, ca);
+        SinCos4(_mm_mul_ps(Gather4(rotationY, h, contiguous), toRadians), sb, cb);
+        SinCos4(_mm_mul_ps(Gather4(rotationZ, h, contiguous), toRadians), sc, cc);
+        __m128 sx = Gather4(scaleX, h, contiguous);
+        __m128 sy = Gather4(scaleY, h, contiguous);
+        __m128 sz = Gather4(scaleZ, h, contiguous);
+
+        __m128 sasb = _mm_mul_ps(sa, sb);
+        __m128 casb = _mm_mul_ps(ca, sb);
+
+        __m128 c0x = _mm_mul_ps(_mm_mul_ps(cb, cc), sx);
+        __m128 c0y = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sasb, cc), _mm_mul_ps(ca, sc)), sx);
+        __m128 c0z = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sa, sc), _mm_mul_ps(casb, cc)), sx);
+        __m128 c0w = zero;
+
+        __m128 c1x = _mm_mul_ps(_mm_sub_ps(zero, _mm_mul_ps(cb, sc)), sy);
+        __m128 c1y = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(ca, cc), _mm_mul_ps(sasb, sc)), sy);
+        __m128 c1z = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(casb, sc), _mm_mul_ps(sa, cc)), sy);
+        __m128 c1w = zero;
+
+        __m128 c2x = _mm_mul_ps(sb, sz);
+        __m128 c2y = _mm_mul_ps(_mm_sub_ps(zero, _mm_mul_ps(sa, cb)), sz);
+        __m128 c2z = _mm_mul_ps(_mm_mul_ps(ca, cb), sz);
+        __m128 c2w = zero;
+
+        __m128 c3x = Gather4(positionX, h, contiguous);
+        __m128 c3y = Gather4(positionY, h, contiguous);
+        __m128 c3z = Gather4(positionZ, h, contiguous);
+        __m128 c3w = one;
+
+        _MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+        _MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+        _MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+        _MM_TRANSPOSE4_PS(c3x, c3y, c3z, c3w);
+
+        const __m128 columns[4][4] = {
+            { c0x, c1x, c2x, c3x }, { c0y, c1y, c2y, c3y }, { c0z, c1z, c2z, c3z }, { c0w, c1w, c2w, c3w }
+        };
+        for (int lane = 0; lane < 4; lane++) {
+            float* matrix = &localMatrices[h[lane]][0][0];
+            for (int column = 0; column < 4; column++) {
+                _mm_storeu_ps(matrix + column * 4, columns[lane][column]);
+            }
+        }
+    }
+
+    // Los que no llenan un lote de cuatro
+    ComputeLocalMatricesScalar(handles + i, count - i);
+}
+
+void TransformSystem::ComputeLocalMatricesScalar(const int* handles, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int handle = handles[i];
+        glm::mat4 matrix = glm::translate(glm::mat4(1.0f), GetPosition(handle));
+        matrix = glm::rotate(matrix, glm::radians(rotationX[handle]), glm::vec3(1.0f, 0.0f, 0.0f));
+        matrix = glm::rotate(matrix, glm::radians(rotationY[handle]), glm::vec3(0.0f, 1.0f, 0.0f));
+        matrix = glm::rotate(matrix, glm::radians(rotationZ[handle]), glm::vec3(0.0f, 0.0f, 1.0f));
+        localMatrices[handle] = glm::scale(matrix, GetScale(handle));
+    }
+}
+
+void TransformSystem::Update(std::vector<int>& changed) {
+    // Los handles liberados después de marcarse siguen en la lista
+    dirtyLocals.erase(std::remove_if(dirtyLocals.begin(), dirtyLocals.end(), [&](int handle) {
+        return (flags[handle] & FREE) != 0;
+    }), dirtyLocals.end());
+    ComputeLocalMatrices(dirtyLocals.data(), dirtyLocals.size());
+    dirtyLocals.clear();
+
+    for (int root : dirtyRoots) {
+        flags[root] &= ~ROOT_QUEUED;
+        // Una raíz encolada que después se enlazó a otro padre ya se visita desde su nueva raíz
+        if ((flags[root] & FREE) || parents[root] != NULL_HANDLE) continue;
+        UpdateWorld(root, changed);
+    }
+    dirtyRoots.clear();
+}
+
+// Baja solo por las ramas marcadas; a partir del primer handle que cambia se recalcula todo su subárbol.
+// Con una pila propia en lugar de recursión, para que una cadena de padres muy larga no agote la pila del hilo.
+void TransformSystem::UpdateWorld(int root, std::vector<int>& changed) {
+    worldStack.clear();
+    worldStack.push_back({ root, false });
+    while (!worldStack.empty()) {
+        int handle = worldStack.back().first;
+        bool dirty = worldStack.back().second || (flags[handle] & LOCAL_DIRTY);
+        worldStack.pop_back();
+
+        if (dirty) {
+            int parent = parents[handle];
+            if (parent == NULL_HANDLE) worldMatrices[handle] = localMatrices[handle];
+            else MultiplyMatrices(worldMatrices[parent], localMatrices[handle], worldMatrices[handle]);
+            changed.push_back(handle);
+        }
+        else if (!(flags[handle] & CHILD_DIRTY)) {
+            continue;
+        }
+
+        // El padre ya está calculado cuando se saca cada hijo
+        flags[handle] &= ~(LOCAL_DIRTY | CHILD_DIRTY);
+        for (int child = firstChildren[handle]; child != NULL_HANDLE; child = nextSiblings[child]) {
+            worldStack.push_back({ child, dirty });
+        }
+    }
+}
+
+TransformSystem::BenchmarkResult TransformSystem::RunBenchmark(size_t count, int iterations) {
+    using clock = std::chrono::high_resolution_clock;
+
+    TransformSystem system;
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> positions(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angles(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> scales(0.5f, 2.0f);
+    for (size_t i = 0; i < count; i++) {
+        int handle = system.Create(nullptr);
+        system.SetPosition(handle, glm::vec3(positions(random), positions(random), positions(random)));
+        system.SetRotation(handle, glm::vec3(angles(random), angles(random), angles(random)));
+        system.SetScale(handle, glm::vec3(scales(random), scales(random), scales(random)));
+    }
+
+    std::vector<int> changed;
+    changed.reserve(count);
+    system.Update(changed);
+
+    // Cada iteración simula un frame en el que se mueven todos los objetos
+    auto start = clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (size_t handle = 0; handle < count; handle++) {
+            system.rotationY[handle] += 1.0f;
+            system.MarkDirty(int(handle));
+        }
+        changed.clear();
+        system.Update(changed);
+    }
+    float systemMs = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+    // Referencia: los mismos objetos con la disposición anterior, cada GameObject en su propia reserva del heap
+    // con el nombre, los vec3 de la transformación y el resto de miembros entre objeto y objeto. Cada frame se
+    // calcula T * Rx * Ry * Rz * S con glm por objeto; sin jerarquía, la matriz de mundo es la local.
+    struct LegacyObject {
+        std::string name;
+        glm::vec3 position;
+        glm::vec3 scale;
+        glm::vec3 rotation;
+        unsigned char otherMembers[192];  // Lo que ocupaban el ModelLoader y el Material
+        glm::mat4 transform;
+    };
+    random.seed(1234);
+    std::vector<std::unique_ptr<LegacyObject>> legacyObjects;
+    legacyObjects.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        auto object = std::make_unique<LegacyObject>();
+        object->name = "GameObject" + std::to_string(i);
+        object->position = glm::vec3(positions(random), positions(random), positions(random));
+        object->rotation = glm::vec3(angles(random), angles(random), angles(random));
+        object->scale = glm::vec3(scales(random), scales(random), scales(random));
+        legacyObjects.push_back(std::move(object));
+    }
+
+    start = clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (const auto& object : legacyObjects) {
+            object->rotation.y += 1.0f;
+            glm::mat4 matrix = glm::translate(glm::mat4(1.0f), object->position);
+            matrix = glm::rotate(matrix, glm::radians(object->rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+            matrix = glm::rotate(matrix, glm::radians(object->rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+            matrix = glm::rotate(matrix, glm::radians(object->rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+            object->transform = glm::scale(matrix, object->scale);
+        }
+    }
+    float legacyMs = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+    BenchmarkResult result;
+    result.count = count;
+    result.iterations = iterations;
+    result.systemMs = systemMs / iterations;
+    result.legacyMs = legacyMs / iterations;
+    return result;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class GameObject;
+
+// Transformaciones de todos los GameObjects guardadas como estructura de arrays: cada componente en su propio
+// array contiguo, indexado por el handle del objeto. Las matrices locales de los objetos modificados se
+// calculan por lotes de cuatro con SSE y las de mundo en una pasada que solo baja por las ramas marcadas.
+class TransformSystem {
+public:
+    static constexpr int NULL_HANDLE = -1;
+
+    static TransformSystem& GetInstance() {
+        static TransformSystem instance;
+        return instance;
+    }
+
+    int Create(GameObject* owner);
+    void Destroy(int handle);
+
+    void SetPosition(int handle, const glm::vec3& position);
+    void SetRotation(int handle, const glm::vec3& rotation);  // Grados, aplicados en orden X, Y, Z
+    void SetScale(int handle, const glm::vec3& scale);
+    glm::vec3 GetPosition(int handle) const { return glm::vec3(positionX[handle], positionY[handle], positionZ[handle]); }
+    glm::vec3 GetRotation(int handle) const { return glm::vec3(rotationX[handle], rotationY[handle], rotationZ[handle]); }
+    glm::vec3 GetScale(int handle) const { return glm::vec3(scaleX[handle], scaleY[handle], scaleZ[handle]); }
+
+    // Solo enlaza los handles; los cambios de posición para conservar el mundo los decide el GameObject
+    void SetParent(int handle, int parentHandle);
+
+    // Referencias válidas hasta que se crea otro handle (los arrays pueden crecer)
+    const glm::mat4& GetLocalMatrix(int handle) const { return localMatrices[handle]; }
+    const glm::mat4& GetWorldMatrix(int handle) const { return worldMatrices[handle]; }
+    GameObject* GetOwner(int handle) const { return owners[handle]; }
+
+    // Recalcula las matrices pendientes y añade a changed los handles cuya matriz de mundo ha cambiado
+    void Update(std::vector<int>& changed);
+
+    size_t GetCount() const { return owners.size() - freeHandles.size(); }
+
+    struct BenchmarkResult {
+        size_t count = 0;
+        int iterations = 0;
+        float systemMs = 0.0f;  // Media por frame con TransformSystem: marcado, lote SSE y propagación
+        float legacyMs = 0.0f;  // Media por frame con la disposición anterior: un objeto en el heap por GameObject y glm
+    };
+
+    // Mueve count objetos durante iterations frames con TransformSystem (en un sistema aparte) y con la
+    // disposición que tenían antes los GameObjects, y devuelve el tiempo medio por frame de cada uno
+    static BenchmarkResult RunBenchmark(size_t count, int iterations);
+
+private:
+    TransformSystem() = default;
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    enum Flags : uint8_t {
+        LOCAL_DIRTY = 1,   // Cambió la transformación local o el padre
+        CHILD_DIRTY = 2,   // Algún descendiente tiene LOCAL_DIRTY
+        ROOT_QUEUED = 4,   // Está en dirtyRoots
+        FREE = 8
+    };
+
+    void MarkDirty(int handle);
+    void ComputeLocalMatrices(const int* handles, size_t count);
+    void ComputeLocalMatricesScalar(const int* handles, size_t count);
+    void UpdateWorld(int root, std::vector<int>& changed);
+    void Unlink(int handle);
+
+    // Componentes en arrays separados para recorrerlos en orden y cargarlos de cuatro en cuatro
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> rotationX, rotationY, rotationZ;
+    std::vector<float> scaleX, scaleY, scaleZ;
+    std::vector<glm::mat4> localMatrices;
+    std::vector<glm::mat4> worldMatrices;
+
+    // Jerarquía como listas enlazadas de hermanos
+    std::vector<int> parents, firstChildren, nextSiblings, previousSiblings;
+    std::vector<uint8_t> flags;
+    std::vector<GameObject*> owners;
+
+    std::vector<int> freeHandles;
+    std::vector<int> dirtyLocals;  // Handles con LOCAL_DIRTY, para el lote de matrices locales
+    std::vector<int> dirtyRoots;   // Raíces de las que cuelga algún cambio
+    std::vector<std::pair<int, bool>> worldStack;  // Pendientes de UpdateWorld y si su padre cambió; se reutiliza
+};
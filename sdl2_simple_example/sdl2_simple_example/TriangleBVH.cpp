@@ -0,0 +1,191 @@
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <numeric>
+
+static const int SAH_BINS = 12;
+static const uint32_t MAX_LEAF_TRIANGLES = 4;
+
+static glm::vec3 GetPosition(const MeshData& mesh, uint32_t index) {
+    const Vertex& vertex = mesh.vertices[index];
+    return glm::vec3(vertex.x, vertex.y, vertex.z);
+}
+
+static float SurfaceArea(const AABB& box) {
+    if (!box.isValid()) return 0.0f;
+    glm::vec3 size = box.max - box.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+void TriangleBVH::build(const MeshData& mesh) {
+    nodes.clear();
+    size_t triangleCount = mesh.indices.size() / 3;
+    triangles.resize(triangleCount);
+    std::iota(triangles.begin(), triangles.end(), 0u);
+    if (triangleCount == 0) return;
+
+    // Cajas y centros de cada triángulo, calculados una sola vez
+    std::vector<AABB> triangleBoxes(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (size_t i = 0; i < triangleCount; i++) {
+        for (int k = 0; k < 3; k++) {
+            triangleBoxes[i].add(GetPosition(mesh, mesh.indices[i * 3 + k]));
+        }
+        centroids[i] = triangleBoxes[i].getCenter();
+    }
+
+    nodes.reserve(triangleCount * 2);
+    nodes.push_back({ AABB(), 0, uint32_t(triangleCount) });
+
+    std::vector<uint32_t> pending = { 0 };
+    while (!pending.empty()) {
+        uint32_t nodeIndex = pending.back();
+        pending.pop_back();
+
+        Node& node = nodes[nodeIndex];
+        AABB centroidBounds;
+        for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+            node.box.add(triangleBoxes[triangles[i]]);
+            centroidBounds.add(centroids[triangles[i]]);
+        }
+        if (node.count <= MAX_LEAF_TRIANGLES) continue;
+
+        // Se busca el corte que minimiza el coste SAH repartiendo los centros en cubetas por cada eje
+        int bestAxis = -1;
+        int bestSplit = 0;
+        float bestCost = SurfaceArea(node.box) * float(node.count);  // Coste de dejarlo como hoja
+        for (int axis = 0; axis < 3; axis++) {
+            float minCentroid = centroidBounds.min[axis];
+            float extent = centroidBounds.max[axis] - minCentroid;
+            if (extent <= 0.0f) continue;
+
+            AABB binBoxes[SAH_BINS];
+            uint32_t binCounts[SAH_BINS] = {};
+            float scale = SAH_BINS / extent;
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                uint32_t triangle = triangles[i];
+                int bin = std::min(SAH_BINS - 1, int((centroids[triangle][axis] - minCentroid) * scale));
+                binCounts[bin]++;
+                binBoxes[bin].add(triangleBoxes[triangle]);
+            }
+
+            // Áreas y cuentas acumuladas desde la izquierda y desde la derecha para cada posible corte
+            float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+            uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+            AABB leftBox, rightBox;
+            uint32_t leftSum = 0, rightSum = 0;
+            for (int i = 0; i < SAH_BINS - 1; i++) {
+                leftSum += binCounts[i];
+                leftCount[i] = leftSum;
+                leftBox.add(binBoxes[i]);
+                leftArea[i] = SurfaceArea(leftBox);
+
+                rightSum += binCounts[SAH_BINS - 1 - i];
+                rightCount[SAH_BINS - 2 - i] = rightSum;
+                rightBox.add(binBoxes[SAH_BINS - 1 - i]);
+                rightArea[SAH_BINS - 2 - i] = SurfaceArea(rightBox);
+            }
+
+            for (int i = 0; i < SAH_BINS - 1; i++) {
+                float cost = leftArea[i] * float(leftCount[i]) + rightArea[i] * float(rightCount[i]);
+                if (leftCount[i] > 0 && rightCount[i] > 0 && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+        if (bestAxis < 0) continue;
+
+        float minCentroid = centroidBounds.min[bestAxis];
+        float scale = SAH_BINS / (centroidBounds.max[bestAxis] - minCentroid);
+        uint32_t* begin = triangles.data() + node.leftFirst;
+        uint32_t* middle = std::partition(begin, begin + node.count, [&](uint32_t triangle) {
+            int bin = std::min(SAH_BINS - 1, int((centroids[triangle][bestAxis] - minCentroid) * scale));
+            return bin <= bestSplit;
+        });
+
+        uint32_t leftCountSplit = uint32_t(middle - begin);
+        uint32_t first = node.leftFirst;
+        uint32_t count = node.count;
+        uint32_t leftChild = uint32_t(nodes.size());
+        node.leftFirst = leftChild;
+        node.count = 0;
+
+        // node deja de ser válido: push_back puede mover el array
+        nodes.push_back({ AABB(), first, leftCountSplit });
+        nodes.push_back({ AABB(), first + leftCountSplit, count - leftCountSplit });
+        pending.push_back(leftChild);
+        pending.push_back(leftChild + 1);
+    }
+}
+
+// Möller-Trumbore, sin descartar caras traseras (se seleccionan también desde dentro)
+static bool RayTriangle(const Ray& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float& t) {
+    glm::vec3 edge1 = b - a;
+    glm::vec3 edge2 = c - a;
+    glm::vec3 p = glm::cross(ray.direction, edge2);
+    float determinant = glm::dot(edge1, p);
+    if (std::abs(determinant) < 1e-12f) return false;
+
+    float inverseDeterminant = 1.0f / determinant;
+    glm::vec3 s = ray.origin - a;
+    float u = glm::dot(s, p) * inverseDeterminant;
+    if (u < 0.0f || u > 1.0f) return false;
+
+    glm::vec3 q = glm::cross(s, edge1);
+    float v = glm::dot(ray.direction, q) * inverseDeterminant;
+    if (v < 0.0f || u + v > 1.0f) return false;
+
+    t = glm::dot(edge2, q) * inverseDeterminant;
+    return t > 0.0f;
+}
+
+bool TriangleBVH::raycast(const MeshData& mesh, const Ray& ray, float maxDistance, float& hitDistance) const {
+    if (nodes.empty()) return false;
+
+    glm::vec3 inverseDirection = 1.0f / ray.direction;
+    float best = maxDistance;
+    bool hit = false;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (RayBoxEnter(node.box, ray.origin, inverseDirection, best) < 0.0f) continue;
+
+        if (node.count > 0) {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                uint32_t triangle = triangles[i];
+                float t;
+                if (RayTriangle(ray, GetPosition(mesh, mesh.indices[triangle * 3]), GetPosition(mesh, mesh.indices[triangle * 3 + 1]),
+                                GetPosition(mesh, mesh.indices[triangle * 3 + 2]), t) && t < best) {
+                    best = t;
+                    hit = true;
+                }
+            }
+            continue;
+        }
+
+        // Se apila primero el hijo más lejano para visitar antes el cercano y podar más con su impacto
+        uint32_t left = node.leftFirst;
+        uint32_t right = left + 1;
+        float leftEnter = RayBoxEnter(nodes[left].box, ray.origin, inverseDirection, best);
+        float rightEnter = RayBoxEnter(nodes[right].box, ray.origin, inverseDirection, best);
+        if (leftEnter >= 0.0f && rightEnter >= 0.0f) {
+            if (leftEnter < rightEnter) std::swap(left, right);
+            stack.push_back(left);
+            stack.push_back(right);
+        }
+        else if (leftEnter >= 0.0f) {
+            stack.push_back(left);
+        }
+        else if (rightEnter >= 0.0f) {
+            stack.push_back(right);
+        }
+    }
+
+    if (hit) hitDistance = best;
+    return hit;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Mesh.h"
+#include "Bounds.h"
+
+// BVH estático sobre los triángulos de una malla, para lanzar rayos contra la geometría exacta (selección con
+// el ratón). Se construye con SAH por cubetas y se guarda en un array plano: los dos hijos de un nodo interior
+// van seguidos.
+class TriangleBVH {
+public:
+    void build(const MeshData& mesh);
+    bool isBuilt() const { return !nodes.empty(); }
+
+    // Triángulo más cercano cortado por el rayo (en el espacio de la malla) antes de maxDistance
+    bool raycast(const MeshData& mesh, const Ray& ray, float maxDistance, float& hitDistance) const;
+
+    size_t getNodeCount() const { return nodes.size(); }
+
+private:
+    struct Node {
+        AABB box;
+        uint32_t leftFirst;  // Hoja: primer triángulo en triangles; interior: índice del hijo izquierdo
+        uint32_t count;      // Triángulos de la hoja; 0 en los nodos interiores
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> triangles;  // Índices de triángulo reordenados para que cada hoja sea un rango seguido
+};
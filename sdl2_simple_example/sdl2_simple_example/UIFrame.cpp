@@ -0,0 +1,39 @@
+#include "UIFrame.h"
+#include "imgui.h"
+#include "imgui_impl_sdl2.h"
+#include "imgui_impl_opengl3.h"
+#include "Profiler.h"
+#include <chrono>
+
+using hrclock = std::chrono::high_resolution_clock;
+
+void UIFrame::Register(const char* name, DrawFunction draw, bool* visible) {
+    panels.push_back({ name, std::move(draw), visible });
+}
+
+void UIFrame::Render() {
+    auto start = hrclock::now();
+    {
+        PROFILE_SCOPE("UI Build");
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplSDL2_NewFrame();
+        ImGui::NewFrame();
+
+        for (const Panel& panel : panels) {
+            if (panel.visible && !*panel.visible) continue;
+            PROFILE_SCOPE(panel.name);
+            panel.draw();
+        }
+    }
+    auto built = hrclock::now();
+    {
+        PROFILE_SCOPE("UI Draw");
+        PROFILE_GPU_SCOPE("UI Draw");
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    auto drawn = hrclock::now();
+
+    timings.buildMs = std::chrono::duration<float, std::milli>(built - start).count();
+    timings.drawMs = std::chrono::duration<float, std::milli>(drawn - built).count();
+}
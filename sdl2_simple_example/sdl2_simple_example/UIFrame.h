@@ -0,0 +1,34 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+// Coste del último frame de interfaz en la CPU, en milisegundos
+struct UITimings {
+    float buildMs = 0.0f;  // NewFrame y las llamadas de todos los paneles
+    float drawMs = 0.0f;   // ImGui::Render y el envío de las listas de dibujo a OpenGL
+};
+
+// Único dueño del frame de ImGui: los paneles se registran una vez y Render los construye y dibuja todos en una
+// sola pasada por frame. La construcción y el dibujado van en zonas propias del profiler (el dibujado también
+// en la GPU), separadas de la escena.
+class UIFrame {
+public:
+    using DrawFunction = std::function<void()>;
+
+    // visible puede ser nullptr para los paneles que deciden solos si se muestran (menú, carga...)
+    void Register(const char* name, DrawFunction draw, bool* visible = nullptr);
+
+    void Render();
+
+    const UITimings& GetTimings() const { return timings; }
+
+private:
+    struct Panel {
+        const char* name;  // Literal; también da nombre a su zona del profiler
+        DrawFunction draw;
+        bool* visible;
+    };
+
+    std::vector<Panel> panels;
+    UITimings timings;
+};
@@ -6,19 +6,32 @@
 #include "imgui_impl_sdl2.h"
 #include "imgui_impl_opengl3.h"
 #include "ConfigPanel.h"
+#include "FramePacer.h"
+#include "Logger.h"
 
-TimeManager timeManager;
-
-WindowEditor::WindowEditor(HierarchyPanel& hierarchyPanel)
-    : consolePanel(), configPanel(), hierarchyPanel(hierarchyPanel), inspectorPanel(), mainMenu(),
-    showConsole(true), showConfig(true), showHierarchy(true), showInspector(true) {
+WindowEditor::WindowEditor(HierarchyPanel& hierarchyPanel, MyWindow* window)
+    : consolePanel(), configPanel(), hierarchyPanel(hierarchyPanel), inspectorPanel(), mainMenu(), loadingPanel(), profilerPanel(),
+    showConsole(true), showConfig(true), showHierarchy(true), showInspector(true), showProfiler(false) {
 
     consolePanel = new ConsolePanel();
-    configPanel = new ConfigPanel();
+    Logger::GetInstance().SetConsolePanel(consolePanel);
+    configPanel = new ConfigPanel(window);
     inspectorPanel = new InspectorPanel();
+    loadingPanel = new LoadingPanel();
+    profilerPanel = new ProfilerPanel();
 
     mainMenu = new MainMenu();
 
+    // Orden de construcción de la interfaz en cada frame
+    uiFrame.Register("Main Menu", [this] { mainMenu->Render(showConsole, showConfig, showHierarchy, showInspector, showProfiler); });
+    uiFrame.Register("Console", [this] { consolePanel->Render(); }, &showConsole);
+    uiFrame.Register("Configuration", [this] { configPanel->Render(); }, &showConfig);
+    uiFrame.Register("Hierarchy", [this] { this->hierarchyPanel.Render(*sceneObjects); }, &showHierarchy);
+    uiFrame.Register("Inspector", [this] { inspectorPanel->Render(); }, &showInspector);
+    uiFrame.Register("Profiler", [this] { profilerPanel->Render(); }, &showProfiler);
+    uiFrame.Register("Loading", [this] { loadingPanel->Render(); });
+    configPanel->SetUIFrame(&uiFrame);
+
     consolePanel->Log("Inicio del sistema de juego.", INFO);
     consolePanel->Log("Advertencia: Uso de memoria alto.", WARNING);
     consolePanel->Log("Info: Jugador ha ingresado a la partida.", INFO);
@@ -26,40 +39,24 @@ WindowEditor::WindowEditor(HierarchyPanel& hierarchyPanel)
 }
 
 WindowEditor::~WindowEditor() {
+    Logger::GetInstance().SetConsolePanel(nullptr);
     delete consolePanel;
     delete configPanel;
     delete inspectorPanel;
     delete mainMenu;
+    delete loadingPanel;
+    delete profilerPanel;
 }
 
 void WindowEditor::Render(const std::vector<std::unique_ptr<GameObject>>& gameObjects) {
-    timeManager.Update();
-    float deltaTime = timeManager.GetDeltaTime();
-    float fps = 1.0f / deltaTime;
-    configPanel->UpdateFPS(fps);
-
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplSDL2_NewFrame();
-    ImGui::NewFrame();
-
-    mainMenu->Render(showConsole, showConfig, showHierarchy, showInspector);
-
-    if (showConsole) {
-        consolePanel->Render();
-    }
-    if (showConfig) {
-        configPanel->Render();
-    }
-    if (showHierarchy) {
-        hierarchyPanel.Render(gameObjects);  // Pasamos el vector de GameObjects
-    }
-
-    if (showInspector) {
-        inspectorPanel->Render();
+    // El mismo deltaTime que usa el bucle principal
+    float deltaTime = FramePacer::GetInstance().GetDeltaTime();
+    if (deltaTime > 0.0f) {
+        configPanel->RecordFrameTime(deltaTime * 1000.0f);
     }
 
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    sceneObjects = &gameObjects;  // Pasamos el vector de GameObjects a la jerarquía
+    uiFrame.Render();
 }
 
 
@@ -6,7 +6,9 @@
 #include "HierarchyPanel.h"
 #include "InspectorPanel.h"
 #include "MainMenu.h"
-#include "TimeManager.h"
+#include "LoadingPanel.h"
+#include "ProfilerPanel.h"
+#include "UIFrame.h"
 #include "MyWindow.h"
 
 class WindowEditor {
@@ -24,9 +26,15 @@ private:
     HierarchyPanel& hierarchyPanel;
     InspectorPanel* inspectorPanel;
     MainMenu* mainMenu;
+    LoadingPanel* loadingPanel;
+    ProfilerPanel* profilerPanel;
+
+    UIFrame uiFrame;
+    const std::vector<std::unique_ptr<GameObject>>* sceneObjects = nullptr;  // Los del frame en curso
 
     bool showConsole;
     bool showConfig;
     bool showHierarchy;
     bool showInspector;
+    bool showProfiler;
 };
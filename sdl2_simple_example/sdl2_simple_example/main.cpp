@@ -19,32 +19,53 @@
 #include "GameObject.h"
 #include "HierarchyPanel.h"
 #include "ConsolePanel.h"
+#include "AssetLoader.h"
+#include "Renderer.h"
+#include "TextureManager.h"
+#include "SpatialIndex.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "Logger.h"
 
 using namespace std;
 using hrclock = chrono::high_resolution_clock;
 using ivec2 = glm::ivec2;
 
 static const ivec2 WINDOW_SIZE(1600, 900);
-static const unsigned int FPS = 60;
-static const auto FRAME_DT = 1.0s / FPS;
+static const float ASSET_UPLOAD_BUDGET_MS = 2.0f; // Tiempo máximo por frame para subir a la GPU los assets cargados en segundo plano
 
 static void init_openGL() {
     glewInit();
     if (!GLEW_VERSION_3_0) throw exception("OpenGL 3.0 API is not available");
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.5, 0.5, 0.5, 1.0);
-
-    glMatrixMode(GL_PROJECTION);
-    glm::mat4 projection = glm::perspective(glm::radians(45.0f), float(WINDOW_SIZE.x) / WINDOW_SIZE.y, 0.1f, 100.0f);
-    glLoadMatrixf(&projection[0][0]);
-    glMatrixMode(GL_MODELVIEW);
+    // Las matrices de la cámara las sube el Renderer en cada frame, al uniform buffer o a OpenGL según el camino
 }
 
 std::vector<std::unique_ptr<GameObject>> gameObjects;
 
 Material defaultMaterial;
 
+// Selecciona el objeto cuya malla queda bajo el cursor: el rayo se filtra con el índice espacial y se
+// comprueba contra los triángulos de los candidatos
+static void pickObject(MyWindow& window, const Camera& camera, HierarchyPanel& hierarchyPanel, int mouseX, int mouseY) {
+    int width, height;
+    SDL_GetWindowSize(window.getWindow(), &width, &height);
+    if (width <= 0 || height <= 0) return;
+
+    PROFILE_SCOPE("Picking");
+    glm::vec2 ndc(2.0f * (mouseX + 0.5f) / width - 1.0f, 1.0f - 2.0f * (mouseY + 0.5f) / height);
+    Ray ray = camera.getPickRay(ndc, float(WINDOW_SIZE.x) / WINDOW_SIZE.y);
+
+    GameObject::UpdateTransforms();
+    SpatialIndex& index = SpatialIndex::GetInstance();
+    index.Update();
+    GameObject* hit = index.Raycast(ray);
+    hierarchyPanel.setSelectedGameObject(hit);
+}
+
 static bool processEvents(MyWindow& window, Camera& camera, HierarchyPanel& hierarchyPanel, float deltaTime) {
+    PROFILE_SCOPE("Events");
     SDL_Event event;
     bool isAltPressed = false;  // Esta variable controlará el estado de la tecla Alt
     while (SDL_PollEvent(&event)) {
@@ -57,7 +78,7 @@ static bool processEvents(MyWindow& window, Camera& camera, HierarchyPanel& hier
                 GameObject* selectedGameObject = hierarchyPanel.getSelectedGameObject();
                 if (selectedGameObject) {
                     glm::vec3 meshSize = selectedGameObject->getMeshSize();
-                    camera.resetFocus(selectedGameObject->getPosition(), meshSize);
+                    camera.resetFocus(selectedGameObject->getWorldPosition(), meshSize);
                 }
             }
             else if (event.key.keysym.sym == SDLK_LSHIFT || event.key.keysym.sym == SDLK_RSHIFT) {
@@ -92,11 +113,18 @@ static bool processEvents(MyWindow& window, Camera& camera, HierarchyPanel& hier
                 // Orbitación con el botón izquierdo y ALT
                 GameObject* selectedGameObject = hierarchyPanel.getSelectedGameObject();
                 if (selectedGameObject) {
-                    camera.processMouseOrbit(event.motion.xrel, -event.motion.yrel, selectedGameObject->getPosition());
+                    camera.processMouseOrbit(event.motion.xrel, -event.motion.yrel, selectedGameObject->getWorldPosition());
                 }
             }
             ImGui_ImplSDL2_ProcessEvent(&event);
             break;
+        case SDL_MOUSEBUTTONDOWN:
+            ImGui_ImplSDL2_ProcessEvent(&event);
+            // Clic izquierdo en el viewport (no sobre una ventana de ImGui ni orbitando con Alt)
+            if (event.button.button == SDL_BUTTON_LEFT && !(SDL_GetModState() & KMOD_ALT) && !ImGui::GetIO().WantCaptureMouse) {
+                pickObject(window, camera, hierarchyPanel, event.button.x, event.button.y);
+            }
+            break;
         case SDL_MOUSEWHEEL:
             camera.processMouseScroll(event.wheel.y);
             break;
@@ -125,6 +153,10 @@ int main(int argc, char** argv) {
 
     // Inicializar OpenGL
     init_openGL();
+    FramePacer::GetInstance().SetMode(PacingMode::VSYNC);
+
+    // Hilos de carga de assets en segundo plano
+    AssetLoader::GetInstance().Start();
 
     // Establecer color por defecto
     defaultMaterial.setDefaultColor(glm::vec3(0.8f, 0.8f, 0.8f));
@@ -169,39 +201,60 @@ int main(int argc, char** argv) {
     WindowEditor editor(hierarchyPanel, &window);  // Asegúrate de que se pase la referencia correcta
 
     Camera camera;
+    FramePacer& framePacer = FramePacer::GetInstance();
+    Profiler& profiler = Profiler::GetInstance();
     float deltaTime = 0.0f;
-    auto lastFrame = hrclock::now();
 
-    // Bucle principal de la aplicación
+    // Bucle principal de la aplicación. El ritmo lo marca el FramePacer (vsync o fecha límite según el modo).
+    // Cada frame del profiler empieza con los eventos, así que incluye también la espera del frame anterior.
+    profiler.BeginFrame();
     while (processEvents(window, camera, hierarchyPanel, deltaTime)) {
-        const auto t0 = hrclock::now();
-        deltaTime = chrono::duration<float>(t0 - lastFrame).count();
-        lastFrame = t0;
+        deltaTime = framePacer.BeginFrame();
 
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Pasar a la consola y al fichero los mensajes que han registrado los hilos desde el frame anterior
+        Logger::GetInstance().Flush();
 
-        // Actualizar la proyección de la cámara
-        glm::mat4 projection = camera.getProjectionMatrix(float(WINDOW_SIZE.x) / WINDOW_SIZE.y);
-        glMatrixMode(GL_PROJECTION);
-        glLoadMatrixf(&projection[0][0]);
-        glMatrixMode(GL_MODELVIEW);
-
-        glm::mat4 view = camera.getViewMatrix();
-        glLoadMatrixf(&view[0][0]);
-
-        // Dibujar cada objeto en la escena
-        for (auto& gameObject : gameObjects) {
-            gameObject->draw();
+        // Terminar en la GPU las cargas que los hilos ya han leído
+        {
+            PROFILE_SCOPE("Asset Upload");
+            PROFILE_GPU_SCOPE("Asset Upload");
+            AssetLoader::GetInstance().Update(ASSET_UPLOAD_BUDGET_MS);
         }
 
-        // Renderizar el editor de la ventana
-        editor.Render(gameObjects);
-        window.swapBuffers();
+        // Dibujar los objetos de la escena que caen dentro de la cámara
+        {
+            PROFILE_SCOPE("Scene");
+            PROFILE_GPU_SCOPE("Scene");
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glm::mat4 projection = camera.getProjectionMatrix(float(WINDOW_SIZE.x) / WINDOW_SIZE.y);
+            glm::mat4 view = camera.getViewMatrix();
+            Renderer::GetInstance().RenderScene(gameObjects, view, projection);
+        }
 
-        const auto t1 = hrclock::now();
-        const auto dt = t1 - t0;
-        if (dt < FRAME_DT) this_thread::sleep_for(FRAME_DT - dt);
+        // Renderizar el editor de la ventana: una sola pasada de ImGui por frame
+        {
+            PROFILE_SCOPE("UI");
+            PROFILE_GPU_SCOPE("UI");
+            editor.Render(gameObjects);
+        }
+        {
+            PROFILE_SCOPE("Swap Buffers");
+            window.swapBuffers();
+        }
+        {
+            PROFILE_SCOPE("Frame Pacing");
+            framePacer.EndFrame();
+        }
+        profiler.BeginFrame();
     }
 
+    // La escena se destruye aquí, con el contexto de OpenGL vivo y antes que los singletons a los que avisa.
+    // Los singletons que guardan objetos de OpenGL los liberan ahora: sus destructores llegan cuando la
+    // ventana ya ha borrado el contexto.
+    gameObjects.clear();
+    AssetLoader::GetInstance().Stop();
+    Renderer::GetInstance().Shutdown();
+    TextureManager::GetInstance().Shutdown();
+
     return 0;
 }
\ No newline at end of file